@@ -85,6 +85,15 @@ SCIP_RETCODE SCIPaddCoefKPC(
         SCIP_Real             val                 /**< coefficient of constraint entry */
 );
 
+/** adds the coefficients of several variables in k-path constraint at once */
+SCIP_RETCODE SCIPaddCoefsKPC(
+        SCIP*                 scip,               /**< SCIP data structure */
+        SCIP_CONS*            cons,               /**< constraint data */
+        int                   nvars,              /**< number of variables to add */
+        SCIP_VAR**            vars,               /**< variables to add to the constraint */
+        SCIP_Real*            vals                /**< coefficients of the constraint entries */
+);
+
 /** creates and adds row for a k-paths constraint */
 SCIP_RETCODE SCIPcreateAndAddRowKPC(
         SCIP*                   scip,
@@ -80,6 +80,15 @@ SCIP_RETCODE SCIPaddCoefSRC(
         SCIP_Real             val                 /**< coefficient of constraint entry */
 );
 
+/** adds the coefficients of several variables in subset row constraint at once */
+SCIP_RETCODE SCIPaddCoefsSRC(
+        SCIP*                 scip,               /**< SCIP data structure */
+        SCIP_CONS*            cons,               /**< constraint data */
+        int                   nvars,              /**< number of variables to add */
+        SCIP_VAR**            vars,               /**< variables to add to the constraint */
+        SCIP_Real*            vals                /**< coefficients of the constraint entries */
+);
+
 /** creates and adds row for a subset row constraint */
 SCIP_RETCODE SCIPcreateAndAddRowSRC(
         SCIP*                   scip,
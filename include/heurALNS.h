@@ -0,0 +1,105 @@
+#ifndef VRP_HEURALNS_H
+#define VRP_HEURALNS_H
+
+
+#include <atomic>
+#include <pthread.h>
+
+#include "scip/scip.h"
+#include "objscip/objscip.h"
+#include "model_data.h"
+#include "tourVRP.h"
+
+using namespace scip;
+
+#define ALNS_SEGMENT 100 // number of iterations after which the weights of the operators are adapted
+#define ALNS_MAX_NOIMPROVE 50 // number of segments without improvement after which the worker waits for a new incumbent
+
+/** adaptive large neighbourhood search running in a background thread
+ *
+ *  The worker only reads its own copy of the model data. It receives the incumbents of SCIP and returns its improved
+ *  solutions through the members guarded by mutex_, the pricer exchanges them at the start of each pricing round.
+ */
+class HeurALNS : public ObjHeur
+{
+    model_data              modelData_;     /**< copy of the model data, used by the worker thread only */
+    SCIP_Real               sumepsilon_;    /**< sum epsilon of SCIP, the worker thread must not call SCIP */
+    pthread_t               thread_;        /**< worker thread */
+    pthread_mutex_t         mutex_;         /**< guards the members shared with the worker thread */
+    pthread_cond_t          cond_;          /**< signals a new incumbent or the end of the search to the worker */
+    bool                    isRunning_;     /**< the worker thread has been started */
+    atomic<bool>            stop_;          /**< the worker thread has to stop */
+    vector<tourVRP>         incumbent_;     /**< tours of each vehicle of the last incumbent of SCIP (shared) */
+    bool                    newIncumbent_;  /**< incumbent_ has not been read by the worker yet (shared) */
+public:
+    SCIP_Real               best_;          /**< value of the best solution of the worker (shared) */
+    vector<tourVRP>         sol_tours_;     /**< tours of each vehicle of the best solution of the worker (shared) */
+    SCIP_SOL*               lastSol_;       /**< last incumbent of SCIP handed to the worker */
+
+    /** default constructor */
+    HeurALNS(
+        SCIP*   scip
+        )
+        : ObjHeur(scip, "vrpALNS", "adaptive large neighbourhood search in a background thread", 'A', -100000, 0, 0, -1,
+                  SCIP_HEURTIMING_AFTERNODE, false),
+        sumepsilon_(SCIPsumepsilon(scip)),
+        thread_(),
+        isRunning_(false),
+        stop_(false),
+        newIncumbent_(false),
+        best_(SCIPinfinity(scip)),
+        lastSol_(nullptr)
+        {
+            pthread_mutex_init(&mutex_, nullptr);
+            pthread_cond_init(&cond_, nullptr);
+        }
+
+    /** destructor */
+    ~HeurALNS()
+    {
+        pthread_cond_destroy(&cond_);
+        pthread_mutex_destroy(&mutex_);
+    }
+
+    /** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+    virtual SCIP_DECL_HEURFREE(scip_free){return SCIP_OKAY;}
+
+    /** initialization method of primal heuristic (called after problem was transformed) */
+    virtual SCIP_DECL_HEURINIT(scip_init){return SCIP_OKAY;}
+
+    /** deinitialization method of primal heuristic (called before transformed problem is freed) */
+    virtual SCIP_DECL_HEUREXIT(scip_exit){return SCIP_OKAY;}
+
+    /** solving process initialization method of primal heuristic (starts the worker thread) */
+    virtual SCIP_DECL_HEURINITSOL(scip_initsol);
+
+    /** solving process deinitialization method of primal heuristic (stops the worker thread) */
+    virtual SCIP_DECL_HEUREXITSOL(scip_exitsol);
+
+    /** execution method of primal heuristic, the search itself runs in the worker thread */
+    virtual SCIP_DECL_HEUREXEC(scip_exec);
+
+    /** whether the worker thread has been started */
+    bool isRunning() const
+    {
+        return isRunning_;
+    }
+
+    /** hands a new incumbent of SCIP to the worker */
+    void setIncumbent(
+        vector<tourVRP>&        tours           /**< tours of the incumbent */
+    );
+
+    /** copies the best solution of the worker if its value is below the upper bound */
+    bool getSolution(
+        SCIP*                   scip,           /**< SCIP data structure */
+        vector<tourVRP>&        tours,          /**< vector to store the tours of the solution */
+        SCIP_Real               upperbound      /**< value the solution has to improve */
+    );
+
+    /** the search of the worker thread, runs until scip_exitsol */
+    void run();
+};
+
+
+#endif //VRP_HEURALNS_H
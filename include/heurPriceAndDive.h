@@ -0,0 +1,54 @@
+#ifndef VRP_HEURPRICEANDDIVE_H
+#define VRP_HEURPRICEANDDIVE_H
+
+
+#include "scip/scip.h"
+#include "objscip/objscip.h"
+#include "model_data.h"
+#include "tourVRP.h"
+
+using namespace scip;
+
+/** price-and-dive heuristic
+ *
+ *  Dives from the root in probing mode: each step fixes the tour variable or the customer-day assignment with the
+ *  largest fractional LP value and resolves the LP with the pricer, such that the dive can use new columns. The pricer
+ *  only generates tours that respect the fixings of the dive. If the LP gets infeasible or exceeds the cutoff bound, the
+ *  last fixing is reverted and its negation is probed instead, up to a bounded number of times. Since the labeling can
+ *  only exclude a single tour, at most one tour variable is fixed to zero per dive.
+ */
+class HeurPriceAndDive : public ObjHeur
+{
+    int                     maxBacktracks_; /**< maximal number of backtracks of a dive */
+    int                     maxPriceRounds_;/**< maximal number of pricing rounds for each LP of the dive (-1: unlimited) */
+public:
+
+    /** default constructor */
+    HeurPriceAndDive(
+        SCIP*   scip
+        );
+
+    /** destructor */
+    ~HeurPriceAndDive(){}
+
+    /** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+    virtual SCIP_DECL_HEURFREE(scip_free){return SCIP_OKAY;}
+
+    /** initialization method of primal heuristic (called after problem was transformed) */
+    virtual SCIP_DECL_HEURINIT(scip_init){return SCIP_OKAY;}
+
+    /** deinitialization method of primal heuristic (called before transformed problem is freed) */
+    virtual SCIP_DECL_HEUREXIT(scip_exit){return SCIP_OKAY;}
+
+    /** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+    virtual SCIP_DECL_HEURINITSOL(scip_initsol){return SCIP_OKAY;}
+
+    /** solving process deinitialization method of primal heuristic (called before branch and bound process data is freed) */
+    virtual SCIP_DECL_HEUREXITSOL(scip_exitsol){return SCIP_OKAY;}
+
+    /** execution method of primal heuristic */
+    virtual SCIP_DECL_HEUREXEC(scip_exec);
+};
+
+
+#endif //VRP_HEURPRICEANDDIVE_H
@@ -0,0 +1,68 @@
+#ifndef VRP_HEURRESTRICTEDMASTER_H
+#define VRP_HEURRESTRICTEDMASTER_H
+
+
+#include <deque>
+
+#include "scip/scip.h"
+#include "objscip/objscip.h"
+#include "model_data.h"
+#include "tourVRP.h"
+
+using namespace scip;
+
+#define RESTRICTED_MASTER_POOL_SIZE 10000 // maximal number of discarded pricing tours kept for the heuristic
+
+/** restricted master heuristic
+ *
+ *  Solves the set partitioning MIP over the generated columns and the negative reduced cost tours that the pricing did
+ *  not add to the master problem in a sub-SCIP with node and time limit. Solutions that only use existing columns are
+ *  submitted directly, the other ones are added by the pricer (like the solutions of dayVarRounding).
+ */
+class HeurRestrictedMaster : public ObjHeur
+{
+    int                     nodeLimit_;     /**< node limit of the sub-SCIP */
+    SCIP_Real               timeLimit_;     /**< time limit of the sub-SCIP */
+    SCIP_Real               minNewCols_;    /**< relative number of new columns and tours needed for another call */
+    int                     lastNCols_;     /**< number of columns and pool tours at the last call */
+    int                     nPoolTours_;    /**< number of tours added to the pool so far */
+    deque<tourVRP>          toursPool_;     /**< elementary negative reduced cost tours discarded by the pricing */
+public:
+    SCIP_Real               best_;          /**< value of the last solution with new columns */
+    vector<tourVRP>         sol_tours_;     /**< tours of the last solution with new columns */
+
+    /** default constructor */
+    HeurRestrictedMaster(
+        SCIP*   scip
+        );
+
+    /** destructor */
+    ~HeurRestrictedMaster(){}
+
+    /** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+    virtual SCIP_DECL_HEURFREE(scip_free){return SCIP_OKAY;}
+
+    /** initialization method of primal heuristic (called after problem was transformed) */
+    virtual SCIP_DECL_HEURINIT(scip_init){return SCIP_OKAY;}
+
+    /** deinitialization method of primal heuristic (called before transformed problem is freed) */
+    virtual SCIP_DECL_HEUREXIT(scip_exit){return SCIP_OKAY;}
+
+    /** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+    virtual SCIP_DECL_HEURINITSOL(scip_initsol);
+
+    /** solving process deinitialization method of primal heuristic (called before branch and bound process data is freed) */
+    virtual SCIP_DECL_HEUREXITSOL(scip_exitsol){return SCIP_OKAY;}
+
+    /** execution method of primal heuristic */
+    virtual SCIP_DECL_HEUREXEC(scip_exec);
+
+    /** keeps a tour of the pricing that was not added to the master problem */
+    void addPoolTour(
+        model_data*             modelData,
+        tourVRP&                tvrp
+    );
+};
+
+
+#endif //VRP_HEURRESTRICTEDMASTER_H
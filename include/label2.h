@@ -14,18 +14,22 @@
 class Label2 {
 public:
     SCIP_Real                   red_costs_;   /**< reduced costs */
-    int                         current_;     /**< last customer */
+    int                         current_;     /**< last customer (local index of the day) */
     int                         cap_;         /**< current capacity */
     double                      time_;        /**< depature time */
     double                      obj_;         /**< current tour costs */
     bitset<neighborhood_size>   ng_memory_;   /**< active ng-neighborhood */
     bitset<neighborhood_size>   visitedEC_;   /**< keeps track of visited enforced customers */
     vector<double>              SRCstate_;    /**< states of subset row cuts */
+    vector<SCIP_Real>           altRedCosts_; /**< reduced costs w.r.t. the additional dual vectors */
+    int                         forbiddenPrefix_; /**< length of the prefix (fw) or suffix (bw) of the forbidden route
+                                                    *   the label equals, -1 if it deviates from the route */
     Label2(
         SCIP_Real           red_costs,
         int                 current,
         int                 cap,
         int                 nSRC,
+        int                 nAltDuals,
         double              time,
         double              obj,
         bitset<neighborhood_size>& ng_memory,
@@ -37,14 +41,17 @@ public:
     time_(time),
     obj_(obj),
     ng_memory_(ng_memory),
-    visitedEC_(visitedEC)
+    visitedEC_(visitedEC),
+    forbiddenPrefix_(-1)
     {
         SRCstate_.resize(nSRC, 0.0);
+        altRedCosts_.resize(nAltDuals, red_costs);
     }
 
     ~Label2()
     = default;
 
+    template<bool withSRC, bool withEC>
     SCIP_Bool dominates(
         Label2*             label,
         ObjPricerVRP*       pricerData,
@@ -63,30 +70,68 @@ public:
         /* ng-neighborhood */
         if(!((ng_memory_ & label->ng_memory_) == ng_memory_))
             return FALSE;
+        /* a prefix of the forbidden route can only dominate the label with the same prefix */
+        if(forbiddenPrefix_ >= 0 && forbiddenPrefix_ != label->forbiddenPrefix_)
+            return FALSE;
         /* visited enforced customer */
-        if(!(visitedEC_ == label->visitedEC_))
+        if(withEC && !(visitedEC_ == label->visitedEC_))
             return FALSE;
         /* reduced costs including potential influence of Subset row cuts */
         double rc_and_src = label->red_costs_;
-        for(int c = 0; c < pricerData->nnonzSRC_; c++)
+        if(withSRC)
         {
-            if(SCIPisGT(scip, SRCstate_[c], label->SRCstate_[c]))
-                rc_and_src += pricerData->SRC_dualv[c];
+            for(int c = 0; c < pricerData->nnonzSRC_; c++)
+            {
+                if(SCIPisGT(scip, SRCstate_[c], label->SRCstate_[c]))
+                    rc_and_src += pricerData->SRC_dualv[c];
+            }
         }
         if(SCIPisGT(scip, red_costs_, rc_and_src))
             return FALSE;
+        /* reduced costs w.r.t. additional dual vectors */
+        for(size_t k = 0; k < altRedCosts_.size(); k++)
+        {
+            if(SCIPisGT(scip, altRedCosts_[k], rc_and_src - label->red_costs_ + label->altRedCosts_[k]))
+                return FALSE;
+        }
 
         return TRUE;
     }
+
+    /** returns the minimal reduced costs over all dual vectors */
+    SCIP_Real getMinRedCosts() const
+    {
+        SCIP_Real minred = red_costs_;
+        for(auto rc : altRedCosts_)
+        {
+            if(rc < minred)
+                minred = rc;
+        }
+        return minred;
+    }
 };
 
-Label2* label_propagate2(
-        model_data*     modelData,
+/** computes the departure times of the extensions of a label to all of its neighbors in one pass over the packed
+ *  arc data, infeasible extensions get the departure time SCIP_INVALID */
+void label_extend_all(
+        model_data*         modelData,
+        Label2*             old_label,
+        arc_table&          arcs,
+        int                 day,
+        vector<double>&     newTimes
+);
+
+/** creates the label of a resource feasible extension along an arc of the packed arc data,
+ *  specialised on the direction and the active resources */
+template<bool isFW, bool withSRC, bool withEC>
+Label2* label_create2(
         ObjPricerVRP*   pricerData,
-        Label2*         oldLabel,
-        SCIP_Bool       isFW,
-        int             end,
-        int             day
+        Label2*         old_label,
+        arc_table&      arcs,
+        int             arc,
+        double          new_time,
+        int             day,
+        bool            shrinkNG
 );
 
 
@@ -9,17 +9,25 @@
 #include "pricer_vrp.h"
 #include "queue"
 
+/** label budget of a labeling thread, the labeling degrades gracefully when it is exceeded */
+typedef struct label_budget {
+    long long int       maxLabels;       /**< number of live labels after which the labeling degrades (-1: unlimited) */
+    long long int       startLabels;     /**< number of live labels of the thread when the labeling started */
+    bool                isHeuristic;     /**< TRUE iff columns may be missed, i.e. the labeling can be stopped */
+    int                 stage;           /**< 0: full labeling, 1: degraded labeling, 2: labeling stopped */
+} label_budget;
+
 /* struct to pass arguments for labeling to worker threads */
 typedef struct arg_struct {
     SCIP*               scip;
     model_data*         modelData;
     ObjPricerVRP*       pricerData;
-    bool                isFarkas;        /**< TRUE for farkas-pricing, FALSE for redcost-pricing */
     bool                isHeuristic;
     bool                getDayVarRed;
-    bool                noDomiance;
+    bool                excludeTour;     /**< TRUE iff the probed tour must not be generated */
     int                 day;
     vector<tourVRP>*    bestTours;
+    vector<double>*     bestRedCosts;
 } arg_struct;
 
 SCIP_RETCODE generateLabels(
@@ -41,18 +49,30 @@ SCIP_RETCODE labelingAlgorithmnParallel(
         bool                        getDayVarRed
 );
 
+/** selects a customer-diverse subset of low reduced cost tours of all days and adds them to the master problem */
+SCIP_RETCODE addSelectedTours(
+        SCIP*                       scip,
+        vrp::ProbDataVRP*           probData,
+        ObjPricerVRP*               pricerData,
+        vector<vector<tourVRP>>&    tours,
+        vector<vector<double>>&     redCosts,
+        bool                        isFarkas
+);
+
 SCIP_RETCODE generateLabelsBiDir(
         SCIP*               scip,
         model_data*         modelData,
         ObjPricerVRP*       pricerData,
         vector<tourVRP>&    bestTours,
-        bool                isFarkas,
+        vector<double>&     bestRedCosts,
         bool                getDayVarRed,
         bool                isHeuristic,
-        bool                noDominance,
+        bool                excludeTour,
         int                 day
 );
 
+/** propagates all labels of a customer, specialised on the direction and the active resources */
+template<bool isFW, bool withSRC, bool withEC>
 SCIP_RETCODE propagateCustomer(
         SCIP*               scip,
         model_data          *modelData,
@@ -62,9 +82,9 @@ SCIP_RETCODE propagateCustomer(
         queue<int>          &indexQ,
         vector<LabelList*>  &labelLists,
         vector<bool>        &isInQ,
-        bool                isFW,
+        vector<double>      &newTimes,
         bool                getDayVarRed,
-        bool                noDominance
+        label_budget        &budget
 );
 
 SCIP_RETCODE concatenateLabels(
@@ -19,6 +19,8 @@ public:
     LabelNode*  nextSib_;
     LabelNode*  prevSib_;
     SCIP_Bool   is_propagated_;
+    SCIP_Bool   is_dead_;       /**< label or one of its ancestors got dominated, removed from its list lazily */
+    static thread_local long long int nAlive_;  /**< number of label nodes alive in the current labeling thread */
     LabelNode(
         Label2*     label2,
         SCIP_Real   value
@@ -33,10 +35,13 @@ public:
         nextSib_ = nullptr;
         prevSib_ = nullptr;
         is_propagated_ = FALSE;
+        is_dead_ = FALSE;
+        nAlive_++;
     }
     ~LabelNode()
     {
         delete label2_;
+        nAlive_--;
     }
     /* delete node from the family tree -> adjust pointers */
     void delete_from_family_tree() const
@@ -59,10 +64,13 @@ class LabelList {
 public:
     LabelNode*  head_;
     int         length_;
+    std::vector<LabelNode*> dead_;  /**< removed propagated labels, kept as long as they have children */
+    size_t      nKeptDead_;         /**< number of dead labels that were kept by the last reclaim */
     LabelList()
     {
         head_ = nullptr;
         length_ = 0;
+        nKeptDead_ = 0;
     }
 
     ~LabelList()
@@ -76,6 +84,8 @@ public:
                 delete node;
             }
         }
+        for(auto dead_node : dead_)
+            delete dead_node;
     }
 
     /** inserts a LabelNode object to the LabelList */
@@ -169,6 +179,61 @@ public:
         node->delete_from_family_tree();
         delete_from_labelList(node);
     }
+
+    /** removes a dead node from the list, non-propagated nodes have no children and get freed immediately */
+    void remove_dead(
+        LabelNode* node
+    ){
+        assert(node->is_dead_);
+        if(node->is_propagated_)
+        {
+            delete_from_labelList(node);
+            node->next_ = nullptr;
+            node->prev_ = nullptr;
+            dead_.push_back(node);
+            /* amortized: reclaim only after the number of kept dead labels doubled */
+            if(dead_.size() >= 2 * nKeptDead_ + 64)
+                reclaim_dead();
+        }else
+        {
+            delete_node(node);
+            delete node;
+        }
+    }
+
+    /** frees the dead labels without children, their parents are alive since they still have a child */
+    void reclaim_dead()
+    {
+        size_t nKept = 0;
+        for(auto dead_node : dead_)
+        {
+            if(dead_node->child_ == nullptr)
+            {
+                dead_node->delete_from_family_tree();
+                delete dead_node;
+            }else
+            {
+                dead_[nKept++] = dead_node;
+            }
+        }
+        dead_.resize(nKept);
+        nKeptDead_ = nKept;
+    }
+
+    /** removes all dead nodes from the list */
+    void compact()
+    {
+        LabelNode* node = head_;
+        LabelNode* next_node;
+        while(node != nullptr)
+        {
+            next_node = node->next_;
+            if(node->is_dead_)
+                remove_dead(node);
+            node = next_node;
+        }
+        reclaim_dead();
+    }
 };
 
 int deleteChildren(
@@ -177,6 +242,7 @@ int deleteChildren(
     LabelNode*                  node
 );
 
+template<bool withSRC, bool withEC>
 int dominance_check2(
         std::vector<LabelList*>&    activeLists,
         std::vector<LabelList*>&    oldLists,
@@ -15,5 +15,13 @@ SCIP_RETCODE localSearchPricing(
         bool                   isFarkas
 );
 
+/** Farkas pricing heuristic: dispatches the customers with positive Farkas duals into new routes */
+SCIP_RETCODE farkasCoveringPricing(
+        SCIP*                       scip,
+        ObjPricerVRP*               pricerData,
+        vrp::ProbDataVRP*           probData,
+        const vector<SCIP_Real>&    dualValues
+);
+
 
 #endif //VRP_LOCAL_SEARCH_PRICING_H
@@ -5,6 +5,9 @@
 #define PARALLEL_LABELING TRUE
 #define MAX_SRC 100
 #define ROUNDING_FACTOR 1000
+#define FLOAT_TRAVEL false // store travel times in single precision
+#define SYMMETRIC_TRAVEL false // store only the upper triangle of the travel matrix (half the memory for large instances)
+#define COLUMN_NAMES false // name the columns after their tours (debugging only, otherwise SCIP gives short names)
 
 #ifndef BRANCHANDPRICE_MODEL_DATA_H
 #define BRANCHANDPRICE_MODEL_DATA_H
@@ -12,6 +15,9 @@
 #include "scip/scip.h"
 #include "json.hpp"
 #include "bitset"
+#include "vector"
+#include <cstdint>
+#include <algorithm>
 
 using namespace std;
 
@@ -30,25 +36,458 @@ typedef struct timeWindow {
     int                 end;
 } timeWindow;
 
+#if FLOAT_TRAVEL
+typedef float travel_t;
+#else
+typedef double travel_t;
+#endif
+
+/** contiguous row-major travel time matrix, accessed as travel[i][j] */
+class travel_matrix {
+public:
+#if SYMMETRIC_TRAVEL
+    /** row of the triangular matrix, the indices get swapped if j < i */
+    class row_ref {
+    public:
+        travel_matrix*  matrix_;
+        int             i_;
+        travel_t& operator[](int j) const
+        {
+            return matrix_->at(i_, j);
+        }
+    };
+#endif
+
+    travel_matrix():
+    n_(0)
+    {}
+
+    /** resizes the matrix to n x n and sets all entries to 0 */
+    void resize(
+        int         n
+    ){
+        n_ = n;
+#if SYMMETRIC_TRAVEL
+        data_.assign((size_t) n * (n + 1) / 2, 0);
+#else
+        data_.assign((size_t) n * n, 0);
+#endif
+    }
+
+    int size() const
+    {
+        return n_;
+    }
+
+    travel_t& at(
+        int         i,
+        int         j
+    ){
+        assert(0 <= i && i < n_ && 0 <= j && j < n_);
+#if SYMMETRIC_TRAVEL
+        if(j < i)
+            std::swap(i, j);
+        return data_[(size_t) i * n_ - (size_t) i * (i - 1) / 2 + (j - i)];
+#else
+        return data_[(size_t) i * n_ + j];
+#endif
+    }
+
+#if SYMMETRIC_TRAVEL
+    row_ref operator[](
+        int         i
+    ){
+        return {this, i};
+    }
+#else
+    travel_t* operator[](
+        int         i
+    ){
+        return &data_[(size_t) i * n_];
+    }
+#endif
+
+private:
+    int                         n_;             /**< number of rows and columns */
+    std::vector<travel_t>       data_;          /**< entries (upper triangle including the diagonal if symmetric) */
+};
+
+/** data of each customer on the days it is available on, stored sparsely (per customer a sorted list of days);
+ *  reading an entry of a day without data returns the missing value, only stored entries can be written. The lookups
+ *  binary search the few days of the customer, such that the memory only grows with the number of stored entries. */
+template<typename T>
+class customer_day_table {
+public:
+    /** data of a customer, accessed per day or iterated over the stored days */
+    class row_ref {
+    public:
+        const customer_day_table*   table_;
+        int                         u_;
+        const T& operator[](int day) const { return table_->get(u_, day); }
+        const T* begin() const { return table_->values_.data() + table_->start_[u_]; }
+        const T* end() const { return table_->values_.data() + table_->start_[u_ + 1]; }
+    };
+
+    /** sets the stored entries, given as (day, value) pairs for each customer */
+    void init(
+        const std::vector<std::vector<std::pair<int, T>>>&  entries,
+        const T&                                            missing
+    ){
+        missing_ = missing;
+        start_.assign(entries.size() + 1, 0);
+        days_.clear();
+        values_.clear();
+        for(size_t u = 0; u < entries.size(); u++)
+        {
+            std::vector<std::pair<int, T>> row = entries[u];
+            std::sort(row.begin(), row.end(), [](auto& left, auto& right){ return left.first < right.first; });
+            for(auto& entry : row)
+            {
+                days_.push_back(entry.first);
+                values_.push_back(entry.second);
+            }
+            start_[u + 1] = (int) days_.size();
+        }
+    }
+
+    /** sets the stored entries of each customer on the given days to value */
+    void init(
+        const std::vector<std::vector<int>>&    days,
+        const T&                                value,
+        const T&                                missing
+    ){
+        std::vector<std::vector<std::pair<int, T>>> entries(days.size());
+        for(size_t u = 0; u < days.size(); u++)
+        {
+            for(int day : days[u])
+                entries[u].emplace_back(day, value);
+        }
+        init(entries, missing);
+    }
+
+    /** position of the entry of customer u on a day, -1 if there is none */
+    int find(
+        int         u,
+        int         day
+    ) const
+    {
+        assert(0 <= day);
+        auto first = days_.begin() + start_[u];
+        auto last = days_.begin() + start_[u + 1];
+        auto it = std::lower_bound(first, last, day);
+        return it != last && *it == day ? (int) (it - days_.begin()) : -1;
+    }
+
+    const T& get(
+        int         u,
+        int         day
+    ) const
+    {
+        int pos = find(u, day);
+        return pos >= 0 ? values_[pos] : missing_;
+    }
+
+    /** stored entry of customer u on a day */
+    T& at(
+        int         u,
+        int         day
+    ){
+        int pos = find(u, day);
+        assert(pos >= 0);
+        return values_[pos];
+    }
+
+    row_ref operator[](
+        int         u
+    ) const
+    {
+        return {this, u};
+    }
+
+private:
+    T                           missing_;       /**< value of days without data */
+    std::vector<int>            start_;         /**< first entry of each customer (+ end) */
+    std::vector<int>            days_;          /**< day of each entry */
+    std::vector<T>              values_;        /**< value of each entry */
+};
+
+/** boolean matrix stored as packed 64 bit words per row, accessed as m[i][j]; the bits behind the last column are always
+ *  zero, such that whole rows can be combined and compared word by word */
+class bit_matrix {
+public:
+    /** reference to a single bit */
+    class bit_ref {
+    public:
+        uint64_t*       word_;
+        uint64_t        mask_;
+        operator bool() const { return (*word_ & mask_) != 0; }
+        bit_ref& operator=(bool value)
+        {
+            if(value)
+                *word_ |= mask_;
+            else
+                *word_ &= ~mask_;
+            return *this;
+        }
+        bit_ref& operator=(const bit_ref& other) { return *this = (bool) other; }
+    };
+
+    /** row of the matrix */
+    class row_ref {
+    public:
+        uint64_t*       words_;
+        bit_ref operator[](int j) const { return {words_ + (j >> 6), (uint64_t) 1 << (j & 63)}; }
+    };
+
+    /** row of a constant matrix */
+    class const_row_ref {
+    public:
+        const uint64_t* words_;
+        bool operator[](int j) const { return (words_[j >> 6] >> (j & 63)) & 1; }
+    };
+
+    bit_matrix():
+    nRows_(0),
+    nCols_(0),
+    nWords_(0)
+    {}
+
+    /** resizes the matrix to nRows x nCols and sets all entries to value */
+    void resize(
+        int         nRows,
+        int         nCols,
+        bool        value
+    ){
+        nRows_ = nRows;
+        nCols_ = nCols;
+        nWords_ = (nCols + 63) / 64;
+        words_.assign((size_t) nRows * nWords_, 0);
+        if(value)
+        {
+            for(int i = 0; i < nRows; i++)
+                setRow(i);
+        }
+    }
+
+    int nRows() const { return nRows_; }
+    int nCols() const { return nCols_; }
+    int nWords() const { return nWords_; }
+
+    row_ref operator[](
+        int         i
+    ){
+        assert(0 <= i && i < nRows_);
+        return {&words_[(size_t) i * nWords_]};
+    }
+
+    const_row_ref operator[](
+        int         i
+    ) const
+    {
+        assert(0 <= i && i < nRows_);
+        return {&words_[(size_t) i * nWords_]};
+    }
+
+    const uint64_t* row(
+        int         i
+    ) const
+    {
+        return &words_[(size_t) i * nWords_];
+    }
+
+    /** sets all entries of row i */
+    void setRow(
+        int         i
+    ){
+        uint64_t* words = &words_[(size_t) i * nWords_];
+        for(int w = 0; w < nWords_; w++)
+            words[w] = ~(uint64_t) 0;
+        if(nCols_ % 64 != 0)
+            words[nWords_ - 1] = ((uint64_t) 1 << (nCols_ % 64)) - 1;
+    }
+
+    /** clears all entries of row i */
+    void resetRow(
+        int         i
+    ){
+        std::fill(words_.begin() + (size_t) i * nWords_, words_.begin() + (size_t) (i + 1) * nWords_, 0);
+    }
+
+    /** sets the matrix to the elementwise AND of a and b */
+    void assignAnd(
+        const bit_matrix&   a,
+        const bit_matrix&   b
+    ){
+        assert(a.words_.size() == b.words_.size());
+        nRows_ = a.nRows_;
+        nCols_ = a.nCols_;
+        nWords_ = a.nWords_;
+        words_.resize(a.words_.size());
+        for(size_t w = 0; w < words_.size(); w++)
+            words_[w] = a.words_[w] & b.words_[w];
+    }
+
+    /** sets the matrix to the elementwise OR of a and b */
+    void assignOr(
+        const bit_matrix&   a,
+        const bit_matrix&   b
+    ){
+        assert(a.words_.size() == b.words_.size());
+        nRows_ = a.nRows_;
+        nCols_ = a.nCols_;
+        nWords_ = a.nWords_;
+        words_.resize(a.words_.size());
+        for(size_t w = 0; w < words_.size(); w++)
+            words_[w] = a.words_[w] | b.words_[w];
+    }
+
+private:
+    int                         nRows_;         /**< number of rows */
+    int                         nCols_;         /**< number of columns */
+    int                         nWords_;        /**< number of words per row */
+    std::vector<uint64_t>       words_;         /**< packed rows */
+};
+
+/** per-day adjacency lists of all customers in compressed sparse row format, accessed as adj[customer][day];
+ *  the lists can be filtered in place (clear + push_back) up to the length they were initialized with */
+class day_adjacency {
+public:
+    /** adjacency list of a customer on a day */
+    class list_ref {
+    public:
+        const int*      first_;
+        const int*      last_;
+        const int* begin() const { return first_; }
+        const int* end() const { return last_; }
+        int size() const { return (int) (last_ - first_); }
+        bool empty() const { return first_ == last_; }
+        int operator[](int k) const { return first_[k]; }
+    };
+
+    /** adjacency lists of a customer on all days */
+    class customer_ref {
+    public:
+        const day_adjacency*    adj_;
+        int                     u_;
+        list_ref operator[](int day) const { return adj_->get(u_, day); }
+    };
+
+    day_adjacency():
+    nC_(0),
+    nDays_(0)
+    {}
+
+    /** packs the lists given per [customer][day], the lists of a day are stored consecutively */
+    void init(
+        const std::vector<std::vector<std::vector<int>>>&  lists
+    ){
+        nC_ = (int) lists.size();
+        nDays_ = nC_ > 0 ? (int) lists[0].size() : 0;
+        start_.assign((size_t) nDays_ * (nC_ + 1), 0);
+        length_.assign((size_t) nDays_ * nC_, 0);
+        index_.clear();
+        for(int day = 0; day < nDays_; day++)
+        {
+            for(int u = 0; u < nC_; u++)
+            {
+                start_[day * (nC_ + 1) + u] = (int) index_.size();
+                length_[day * nC_ + u] = (int) lists[u][day].size();
+                index_.insert(index_.end(), lists[u][day].begin(), lists[u][day].end());
+            }
+            start_[day * (nC_ + 1) + nC_] = (int) index_.size();
+        }
+    }
+
+    list_ref get(
+        int         u,
+        int         day
+    ) const
+    {
+        const int* first = index_.data() + start_[day * (nC_ + 1) + u];
+        return {first, first + length_[day * nC_ + u]};
+    }
+
+    customer_ref operator[](
+        int         u
+    ) const
+    {
+        return {this, u};
+    }
+
+    /** position of the first entry of the list of customer u on a day, data stored per entry can use this layout */
+    int offset(
+        int         u,
+        int         day
+    ) const
+    {
+        return start_[day * (nC_ + 1) + u];
+    }
+
+    /** number of entries of all lists at their initial length */
+    int capacity() const
+    {
+        return (int) index_.size();
+    }
+
+    /** whether v is in the list of customer u on a day */
+    bool contains(
+        int         u,
+        int         day,
+        int         v
+    ) const
+    {
+        list_ref list = get(u, day);
+        return std::find(list.begin(), list.end(), v) != list.end();
+    }
+
+    /** empties the list of a customer on a day, the storage is kept */
+    void clear(
+        int         u,
+        int         day
+    ){
+        length_[day * nC_ + u] = 0;
+    }
+
+    /** appends an entry to the list of a customer on a day (not beyond its initial length) */
+    void push_back(
+        int         u,
+        int         day,
+        int         v
+    ){
+        int pos = start_[day * (nC_ + 1) + u] + length_[day * nC_ + u];
+        assert(pos < start_[day * (nC_ + 1) + u + 1]);
+        index_[pos] = v;
+        length_[day * nC_ + u]++;
+    }
+
+private:
+    int                         nC_;            /**< number of customers + depot */
+    int                         nDays_;         /**< number of days */
+    std::vector<int>            start_;         /**< first entry of each [day][customer] (+ end of the day) */
+    std::vector<int>            length_;        /**< current length of each [day][customer] list */
+    std::vector<int>            index_;         /**< entries of all lists */
+};
+
 typedef struct model_data {
         int                         nC;             /**< number of customers + depot */
         int                         nDays;          /**< number of days */
         int                         nVehicles;      /**< number of vehicles */
 //        int                         max_cap;        /**< capacity of the vehicles */
         SCIP_Bool                   minTravel;      /**< if True min. travel time, else min. num of vehicles used */
+        SCIP_Bool                   setCovering;    /**< if True the customer rows are >= 1 (non-negative duals) and primal
+                                                     *   solutions are repaired to set partitioning */
         vector<int>                 max_caps;       /**< capacities of the vehicles */
         vector<int>                 num_v;          /**< number of each vehicle */
         vector<int>                 dayofVehicle;   /**< day of each vehicle */
         vector<int>                 firstVehicleofday; /**< */
         vector<int>                 demand;         /**< demand of the customers */
         vector<int>                 service;        /**< service time of the customers */
-        vector<vector<double>>      travel;         /**< travel time matrix */
-        vector<vector<timeWindow>>  timeWindows;    /**< time windows for each customer */
+        travel_matrix               travel;         /**< travel time matrix */
+        customer_day_table<timeWindow> timeWindows; /**< time windows for each customer on its available days */
         vector<vector<int>>         availableDays;  /**< list of days with time window for each customer */
         vector<vector<int>>         availableVehicles;  /**< list of vehicles with time window for each customer */
-        vector<vector<vector<int>>> neighbors;      /**< neighbors for each customer and each day */
-        vector<vector<vector<int>>> predecessors;   /**< predecessors for each customer and each day */
-        vector<vector<vector<bool>>>adjacency_k;    /**< adjacency for each day k */
+        day_adjacency               neighbors;      /**< neighbors for each customer and each day */
+        day_adjacency               predecessors;   /**< predecessors for each customer and each day */
         vector<bitset<neighborhood_size>> ng_set;   /**< ng-neighborhood */
 } model_data;
 
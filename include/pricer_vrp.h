@@ -33,10 +33,51 @@ typedef struct node_data {
     double                              node_varfixing_;   /**< the last gap value where variable fixing has been applied */
     vector<bool>                        node_fixedDay_;    /**< days with a 1-fixed variable in subtree */
     vector<bitset<neighborhood_size>>   node_ng_DSSR_;     /**< DSSR data for branching nodes */
-    vector<vector<bool>>                node_timetable_;   /**< timetable for branching nodes */
-    vector<vector<bool>>                node_isForbidden_; /**< isForbidden for branching nodes */
+    bit_matrix                          node_timetable_;   /**< timetable for branching nodes */
+    bit_matrix                          node_isForbidden_; /**< isForbidden for branching nodes */
 } node_data;
 
+/** packed arc data of one day and one labeling direction, built once per pricing call
+ *
+ *  Customers are given by their local index in the day_graph of the day. The arcs of customer u are stored at the
+ *  positions start[u] to start[u+1]-1. For backward labels the time
+ *  windows are mirrored at the end of the planning horizon, such that both directions use the same extension rule:
+ *  arrival = time + travel + preService, departure = max(earliest, arrival) + postService
+ */
+typedef struct arc_table {
+    bool                                isFW;              /**< true iff the table holds the arcs for forward labels */
+    vector<int>                         start;             /**< first arc of each local customer, size n + 1 */
+    vector<int>                         head;              /**< customer the label gets extended to */
+    vector<double>                      travel;            /**< travel time of the arc */
+    vector<double>                      preService;        /**< service time before arrival (backward labels) */
+    vector<double>                      postService;       /**< service time after start of service (forward labels) */
+    vector<double>                      earliest;          /**< earliest start of service at head */
+    vector<double>                      latest;            /**< latest feasible arrival at head */
+    vector<int>                         demand;            /**< demand of head */
+    vector<SCIP_Real>                   price;             /**< arc price in the current pricing iteration */
+    vector<vector<SCIP_Real>>           altPrice;          /**< arc prices w.r.t. each additional dual vector [k][arc] */
+} arc_table;
+
+/** compact subgraph of one day, built once per pricing call
+ *
+ *  The customers available on the day are relabeled densely (local index 0 is the depot), such that labels, ng-memories
+ *  and all lookups of the labeling only work on arrays of the size of the day. Matrices are stored row-major.
+ */
+typedef struct day_graph {
+    int                                 n;                 /**< number of local nodes (depot + customers of the day) */
+    vector<int>                         toGlobal;          /**< global customer of each local node */
+    vector<int>                         toLocal;           /**< local node of each global customer, -1 if not on the day */
+    vector<bitset<neighborhood_size>>   ngSet;             /**< ng-neighborhood of each local node in local indices */
+    vector<char>                        isEnforced;        /**< local node is an enforced customer of the day */
+    vector<char>                        inSRC;             /**< [cut * n + node] node is in the set of the subset row cut */
+    vector<int>                         forbiddenTour;     /**< route that must not be generated in local indices */
+    vector<double>                      travel;            /**< travel times [i * n + j] */
+    vector<char>                        isForbidden;       /**< [i * n + j] arc is not in the current neighborhood of the day */
+    vector<SCIP_Real>                   price;             /**< arc prices [i * n + j] */
+    vector<SCIP_Real>                   boundPrice;        /**< minimal arc prices over all dual vectors [i * n + j] */
+    vector<vector<SCIP_Real>>           altPrice;          /**< arc prices w.r.t. each additional dual vector [k][i * n + j] */
+} day_graph;
+
 /** pricer class */
 class ObjPricerVRP : public ObjPricer
 {
@@ -50,23 +91,50 @@ public:
     ObjPropVarFixing*                       prop_varfixing_; /**< propagator for variable fixing */
     ObjPropTourVarFixing*                   prop_tourfixing_;/**< propagator for variable fixing */
     long long int                           lastID_;         /**< branching node id of last iteration */
+    int                                     lastRepairedSol_;/**< index of the last best solution that was repaired to set
+                                                              *   partitioning, SCIP reuses the solution pointers */
     SCIP_Real                               dual_nVehicle_;  /**< dual value of nVehicle constraint */
     vector<SCIP_Real>                       dualValues_;     /**< dual values of the current iteration */
-    vector<vector<vector<int>>>             neighbors_;      /**< local neighborhood of each [customer][day] */
-    vector<vector<vector<int>>>             predecessors_;   /**< local predecessors of each [customer][day] */
+    vector<SCIP_Real>                       lastDualValues_; /**< dual values of the last redcost pricing iteration */
+    int                                     nDualVectors_;   /**< number of dual vectors per labeling pass (1: only the current duals) */
+    int                                     nAltDuals_;      /**< number of additional dual vectors used in the current labeling */
+    vector<vector<SCIP_Real>>               altDualValues_;  /**< additional dual vectors (convex combinations of current and last duals) */
+    vector<vector<SCIP_Real>>               altArcPrices_;   /**< arc prices w.r.t. each additional dual vector, layout of arcPrices_ */
+    vector<SCIP_Real>                       minArcPrices_;   /**< minimal arc prices over all dual vectors, layout of arcPrices_ */
+    SCIP_Bool                               useSmoothing_;   /**< should the duals be smoothed around a stability center? */
+    bool                                    isSmoothed_;     /**< the current labeling uses the smoothed duals */
+    SCIP_Real                               smoothingFactor_;/**< weight of the stability center, adapted automatically */
+    int                                     smoothingMaxTries_; /**< maximal number of smoothed labelings per round before the LP duals are used */
+    vector<SCIP_Real>                       centerDuals_;    /**< stability center: duals of the last redcost pricing round at the node */
+    vector<SCIP_Real>                       lpDualValues_;   /**< dual values of the LP while pricing with smoothed duals */
+    vector<SCIP_Real>                       subgradient_;    /**< subgradient at the smoothed duals given by the best tour of each day */
+    vector<SCIP_Real>                       dayMinRedCosts_; /**< minimal reduced costs of the routes of each day in the last labeling,
+                                                              *   -infinity if the enumeration stopped early */
+    SCIP_Bool                               useFarkasCovering_; /**< should Farkas pricing try the column pool and a covering
+                                                              *   heuristic before the labeling? */
+    SCIP_Real                               earlyBranchingGap_; /**< relative gap of LP value and Lagrangian bound below which column
+                                                              *   generation stops early at non-root nodes (0: off) */
+    day_adjacency                           neighbors_;      /**< local neighborhood of each [customer][day] */
+    day_adjacency                           predecessors_;   /**< local predecessors of each [customer][day] */
     vector< int >                           eC_;             /**< if customer is enforced, entry will be set to day, else -1 */
     vector< int >                           nEC_;            /**< number of enforced customers for each day */
     vector< bool >                          toDepot_;        /**< if arc to depot is active at current branching node */
     vector< bool >                          fixedDay_;       /**< indicates if a pricing for a day should not be applied */
     vector<SCIP_CONS*>                      eDays_;          /**< constraints of enforced days to receive dual variable from */
-    vector<vector<bool>>                    timetable_;      /**< timetable[customer][day]=TRUE if customer visitable at day, else FALSE */
-    vector<vector<bool>>                    global_timetable_;   /**< timetable[customer][day]=TRUE if customer visitable at day, else FALSE */
-    vector<vector<bool>>                    isForbidden_;    /**< matrix that indicates if an arc between two customers if forbidden due to arc flow branching */
-    vector<vector<bool>>                    global_isForbidden_; /**< matrix that indicates if an arc between two customers if forbidden due to arc flow branching */
-    vector<vector<SCIP_Real>>               arcPrices_;      /**< the costs of traversing the arcs in the given pricing iteration */
-    vector<vector<SCIP_Real>>               dayVarRedCosts_; /**< reduced costs of day-customer assignment variables */
-    vector<vector<SCIP_Real>>               root_dayVarRedCosts_; /**< reduced costs of day-customer assignment variables */
-    vector<vector<SCIP_Real>>               root_dayVarLPObj_; /**< reduced costs of day-customer assignment variables */
+    bit_matrix                              timetable_;      /**< timetable[customer][day]=TRUE if customer visitable at day, else FALSE */
+    bit_matrix                              global_timetable_;   /**< timetable[customer][day]=TRUE if customer visitable at day, else FALSE */
+    bit_matrix                              isForbidden_;    /**< matrix that indicates if an arc between two customers if forbidden due to arc flow branching */
+    bit_matrix                              global_isForbidden_; /**< matrix that indicates if an arc between two customers if forbidden due to arc flow branching */
+    vector<SCIP_Real>                       arcPrices_;      /**< price of each active arc u->v in the given pricing iteration, stored at the
+                                                              *   position of v in neighbors_[u][day]; includes the duals of the day and
+                                                              *   the vehicles (arcs leaving the depot) and the prize of enforced customers */
+    vector<SCIP_Real>                       returnPrices_;   /**< price of the arc from each customer back to the depot */
+    vector<arc_table>                       fwArcs_;         /**< packed arc data for forward labels of each day */
+    vector<arc_table>                       bwArcs_;         /**< packed arc data for backward labels of each day */
+    vector<day_graph>                       dayGraphs_;      /**< compact subgraph of each day */
+    customer_day_table<SCIP_Real>           dayVarRedCosts_; /**< reduced costs of day-customer assignment variables */
+    customer_day_table<SCIP_Real>           root_dayVarRedCosts_; /**< reduced costs of day-customer assignment variables */
+    customer_day_table<SCIP_Real>           root_dayVarLPObj_; /**< reduced costs of day-customer assignment variables */
     vector<vector<SCIP_Real>>               arcRedCosts_;    /**< reduced costs of arc flow variables */
     vector<vector<SCIP_Real>>               root_arcRedCosts_;    /**< reduced costs of arc flow variables */
     vector<vector<SCIP_Real>>               root_arcLPObj_;    /**< reduced costs of arc flow variables */
@@ -80,7 +148,20 @@ public:
     vector<vector<bool>*>                   SRC_Set_;        /**< customer sets of robust cuts */
     vector<double>                          SRC_para_;       /**< parameters of active robust cuts */
     vector<double>                          SRC_dualv;       /**< current dual values of active robust cuts */
+    int                                     maxColsPerDay_;  /**< maximal number of columns per day and pricing round (-1: nC/4 + 1) */
+    int                                     maxCols_;        /**< maximal number of columns per pricing round (-1: unlimited) */
+    int                                     maxCandsPerDay_; /**< maximal number of candidate tours per day for the column selection */
+    int                                     maxPairsPerDay_; /**< maximal number of concatenated label pairs per day */
+    int                                     maxLabels_;      /**< number of live labels per thread after which the exact labeling shrinks the ng-sets */
+    int                                     heurMaxLabels_;  /**< number of live labels per thread after which the heuristic labeling degrades */
+    vector<int>                             labelStage_;     /**< stage of the label budget of each day in the last labeling */
     bool                                    atRoot_;
+    bool                                    isDiving_;       /**< the price-and-dive heuristic is probing */
+    tourVRP                                 diveExcludedTour_; /**< tour rejected by a backtrack of the dive (at most one) */
+    bit_matrix                              diveTimetable_;  /**< timetable of the node the dive started at */
+    vector< int >                           diveEC_;         /**< enforced customers of the node the dive started at */
+    vector< int >                           diveNEC_;        /**< number of enforced customers of the node the dive started at */
+    bool                                    diveAtRoot_;     /**< the dive started at the root node */
     vector<bool>                                     dayisone_;
     vector<long long int>                           nodeisone_;
     vector<int>                                     depthisone_;
@@ -106,7 +187,16 @@ public:
     /** perform pricing */
     SCIP_RETCODE pricing(
         SCIP*              scip,               /**< SCIP data structure */
-        bool               isFarkas            /**< whether we perform Farkas pricing */
+        bool               isFarkas,           /**< whether we perform Farkas pricing */
+        SCIP_Real*         lowerbound,         /**< pointer to store the Lagrangian bound, or nullptr */
+        SCIP_Bool*         stopearly           /**< pointer to store whether column generation can stop, or nullptr */
+    );
+
+    /** Lagrangian bound of the last exact labeling: LP value plus the minimal reduced costs of each day for each of
+     *  its vehicles, -infinity if the minimum of a day is not known */
+    SCIP_Real getLagrangianBound(
+        SCIP*              scip,
+        model_data*        modelData
     );
 
     /** return negative reduced cost tour (uses restricted shortest path dynamic programming algorithm) */
@@ -118,6 +208,38 @@ public:
         bool                    isHeuristic
     );
 
+    /** generates tours with the duals smoothed towards the stability center, decreasing the smoothing on mis-pricing */
+    SCIP_RETCODE smoothed_pricing(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData
+    );
+
+    /** tour that must not be generated again while probing, nullptr if there is none */
+    tourVRP* getExcludedTour(
+            SCIP*                       scip
+    );
+
+    /** saves the pricing graph of the current node before the price-and-dive heuristic starts probing */
+    SCIP_RETCODE startDive();
+
+    /** restricts the pricing of the dive to the given timetable */
+    SCIP_RETCODE setDiveTimetable(
+            model_data*                 modelData,
+            const bit_matrix&           timetable
+    );
+
+    /** restores the pricing graph of the current node after the dive */
+    SCIP_RETCODE endDive(
+            model_data*                 modelData
+    );
+
+    /** Farkas pricing with the column pool and a covering heuristic, success is TRUE if the labeling can be skipped */
+    SCIP_RETCODE farkas_pricing(
+            SCIP*                       scip,
+            vrp::ProbDataVRP*           probData,
+            SCIP_Bool*                  success
+    );
+
     /** return negative reduced cost tour (uses restricted shortest path dynamic programming algorithm) */
     bool heuristic_pricing(
             SCIP*                       scip,
@@ -125,11 +247,31 @@ public:
             bool                   isFarkas
     );
 
+    /** price of the arc u->v on a day, infinity if the arc is not in the current neighborhood */
+    SCIP_Real getArcPrice(
+            int             u,
+            int             v,
+            int             day
+    );
+
     SCIP_Real getTourVRPredcosts(
-            model_data*     modelData,
             tourVRP&        tvrp
     );
 
+    /** reduced costs of a tour w.r.t. the LP duals, given its reduced costs w.r.t. the smoothed duals */
+    SCIP_Real getLPRedCosts(
+            model_data*     modelData,
+            tourVRP&        tvrp,
+            SCIP_Real       redcosts
+    );
+
+    /** sets the subgradient at the smoothed duals from the best found tour of each day */
+    void setSubgradient(
+            model_data*                 modelData,
+            vector<vector<tourVRP>>&    tours,
+            vector<vector<double>>&     redCosts
+    );
+
     SCIP_RETCODE set_current_graph(
         model_data*         modelData
     );
@@ -147,6 +289,13 @@ public:
         bool                isFarkas
     );
 
+    /** sets the additional dual vectors and their arc prices for current pricing iteration */
+    SCIP_RETCODE setAltDualVectors(
+        SCIP*               scip,
+        model_data*         modelData,
+        bool                isFarkas
+    );
+
     /** includes subset row cut data into pricing */
     SCIP_RETCODE includeSRCpricingData(
         SCIP*               scip,
@@ -14,12 +14,12 @@ using namespace std;
 
 SCIP_RETCODE printTimetable(
         model_data*             modelData,
-        vector<vector<bool>>&   timetable
+        bit_matrix&             timetable
 );
 
 SCIP_RETCODE printIsForbidden(
         model_data*             modelData,
-        vector<vector<bool>>&   isForbidden
+        bit_matrix&             isForbidden
 );
 
 #endif //PRINTER_H
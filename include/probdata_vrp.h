@@ -5,6 +5,8 @@
 
 #include <cassert>
 #include <utility>
+#include <memory>
+#include <unordered_map>
 
 #include "stdio.h"
 #include "model_data.h"
@@ -14,6 +16,94 @@
 #include "tourVRP.h"
 
 using namespace std;
+
+/** append-only storage of the customer sequences of all columns; the sequences are packed into large blocks, such
+ *  that they never move and a column needs no allocation of its own */
+class column_store {
+public:
+    column_store():
+    used_(0)
+    {}
+
+    /** stores a copy of the sequence and returns its address */
+    const int* add(
+        const int*      tour,
+        int             length
+    );
+
+private:
+    static constexpr int            BLOCK_SIZE = 1 << 16;   /**< number of customers per block */
+    int                             used_;                  /**< used entries of the last block */
+    vector<unique_ptr<int[]>>       blocks_;                /**< blocks of sequences */
+};
+
+/** inverted index from arcs, customers and days to the columns (positions in vars_) containing them; it is extended
+ *  whenever a column is added to the problem data, such that the lists are sorted by position */
+class column_index {
+public:
+    column_index():
+    nC_(0)
+    {}
+
+    void init(
+        int             nC,
+        int             nDays
+    );
+
+    /** registers the column at position col with its tour (depot excluded) on a day */
+    void add(
+        int             col,
+        int             day,
+        const int*      tour,
+        int             length
+    );
+
+    /** columns that use the arc u->v (0 is the depot) */
+    const vector<int>& getArc(
+        int             u,
+        int             v
+    ) const;
+
+    /** columns that visit customer u on a day */
+    const vector<int>& getCustomerDay(
+        int             u,
+        int             day
+    ) const;
+
+    /** columns that visit customer u */
+    const vector<int>& getCustomer(
+        int             u
+    ) const
+    {
+        return byCustomer_[u];
+    }
+
+    /** columns of a day */
+    const vector<int>& getDay(
+        int             day
+    ) const
+    {
+        return byDay_[day];
+    }
+
+    /** collects the columns from position first on that use a forbidden arc or visit a customer on a day that is not in
+     *  its timetable (a column can be collected more than once) */
+    void getConflicts(
+        const bit_matrix&   isForbidden,
+        const bit_matrix&   timetable,
+        int                 first,
+        vector<int>&        cols
+    ) const;
+
+private:
+    int                                     nC_;            /**< number of customers + depot */
+    unordered_map<long long, vector<int>>   byArc_;         /**< columns of each used arc, key u * nC + v */
+    unordered_map<long long, vector<int>>   byCustomerDay_; /**< columns of each visited customer-day, key day * nC + u */
+    vector<vector<int>>                     byCustomer_;    /**< columns of each customer */
+    vector<vector<int>>                     byDay_;         /**< columns of each day */
+    vector<int>                             empty_;         /**< list returned for unused keys */
+};
+
 namespace vrp
 {
 
@@ -29,6 +119,8 @@ class ProbDataVRP : public scip::ObjProbData
         vector<SCIP_CONS*>      cons_;
         vector<SCIP_VAR*>       emptyVars_;
         vector<SCIP_VAR*>       nonzeroVars_;
+        column_store            columns_;       /**< customer sequences of the columns created with this problem data */
+        column_index            columnIndex_;   /**< columns of each arc, customer and day (positions in vars_) */
         int                     use_propagator_;
         double                  fw_time_;
         double                  bd_time_;
@@ -107,6 +199,7 @@ class ProbDataVRP : public scip::ObjProbData
             nGaps_success_.resize(14);
             nVal_calls.resize(10);
             nVal_success_.resize(10);
+            columnIndex_.init(modelData->nC, modelData->nDays);
         }
 
         /** destructor */
@@ -28,6 +28,15 @@ SCIP_RETCODE add_tour_variable(
         tourVRP&                    tvrp
 );
 
+/** adds the columns of several priced tours to the model in one batch */
+SCIP_RETCODE add_tour_variables(
+        SCIP*                       scip,
+        vrp::ProbDataVRP*           probData,
+        SCIP_Bool                   isFarkas,
+        char*                       algoName,
+        vector<tourVRP*>&           tours
+);
+
 double getExchangeCosts(
         model_data*             modelData,
         vector<int>&            tour,
@@ -64,4 +73,16 @@ bool violatesNGProperty(
         vector<int>&                        tour
 );
 
+/** collects the tours of a solution. Customers that are visited more than once (set covering master) are removed
+ *  from all but one of their tours, such that the tours form a set partitioning solution. If a visit cannot be removed
+ *  without violating a time window, success is set to FALSE and the tours are cleared. */
+SCIP_RETCODE getPartitioningTours(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData,
+        SCIP_SOL*               sol,
+        vector<tourVRP>&        tours,
+        bool*                   repaired,
+        bool*                   success
+);
+
 #endif //VRP_TOOLS_VRP_H
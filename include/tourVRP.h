@@ -79,6 +79,14 @@ public:
         int         cust
     );
 
+    /** adds cust to the cheapest spot, extra costs below -sumepsilon count as an improvement (SCIP-free) */
+    SCIP_Bool addNode(
+        model_data* modelData,
+        int         *newpos,
+        int         cust,
+        SCIP_Real   sumepsilon
+    );
+
     SCIP_RETCODE setValues(
             model_data* modelData
     );
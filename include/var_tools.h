@@ -33,4 +33,26 @@ SCIP_RETCODE SCIPsortNonzeroVars(
     vrp::ProbDataVRP*           probData
 );
 
+/** returns whether tour columns were removed from the LP by the column aging, i.e. whether a tour variable is not in
+ *  the LP. Their variables stay in the problem as a column pool and are added back by the problem variable pricing of
+ *  SCIP once their reduced costs are negative. */
+bool SCIPhasPooledColumns(
+    SCIP*                       scip,
+    vrp::ProbDataVRP*           probData
+);
+
+/** appends several variables to the variable and coefficient arrays of a cut constraint and adds them row-wise to its
+ *  LP row (shared by the subset row and the k-path constraints) */
+SCIP_RETCODE SCIPaddVarsToCutRow(
+    SCIP*                       scip,
+    SCIP_ROW*                   cut,            /**< LP row of the constraint */
+    SCIP_VAR***                 consvars,       /**< variable array of the constraint */
+    SCIP_Real**                 conscoeffs,     /**< coefficient array of the constraint */
+    int*                        nconsvars,      /**< number of variables of the constraint */
+    int*                        varssize,       /**< size of the arrays of the constraint */
+    int                         nvars,          /**< number of variables to add */
+    SCIP_VAR**                  vars,           /**< variables to add */
+    SCIP_Real*                  vals            /**< coefficients of the variables to add */
+);
+
 #endif //VRP_VAR_TOOLS_H
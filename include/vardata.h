@@ -7,42 +7,50 @@
 #include "probdata_vrp.h"
 #include "tourVRP.h"
 
+#include <string>
 #include <utility>
 #include <vector>
 
 using namespace std;
 using namespace scip;
 
+/** read-only view of the customer sequence of a column */
+class tour_view {
+public:
+    const int*      tour_;
+    int             length_;
+    const int* begin() const { return tour_; }
+    const int* end() const { return tour_ + length_; }
+    int operator[](int i) const { return tour_[i]; }
+};
+
 class ObjVarDataVRP : public ObjVardata {
 private:
     int             tourLength_;
     int             day_;
     int             capacity_;
+    SCIP_Real       obj_;
     bool            isElementary_;
 public:
-    tourVRP         tourVrp_;
-    vector<int>     tour_;
+    const int*      tour_;          /**< customer sequence, owned by the column store of the problem data */
     ObjVarDataVRP(
-        tourVRP&        tourVrp,
-        vector<int>     tour,
+        const int*      tour,
         int             tourLength,
         int             day,
         int             capacity,
+        SCIP_Real       obj,
         bool            isElementary
     ):
     tourLength_(tourLength),
     day_(day),
     capacity_(capacity),
+    obj_(obj),
     isElementary_(isElementary),
-    tour_(std::move(tour))
-    {
-        tourVrp_.copy(tourVrp);
-    }
+    tour_(tour)
+    {}
 
     ~ObjVarDataVRP() override
-    {
-//        delete &tour_;
-    };
+    = default;
 
 //    virtual SCIP_RETCODE scip_copy( // TODO: delete if we do not need it
 //            SCIP*              scip,               /**< SCIP data structure */
@@ -67,7 +75,7 @@ public:
 
     friend ostream &operator<<(std::ostream &os, const ObjVarDataVRP& vardata) {
         os << "Vardata: (day "<< vardata.day_<< ", length " << vardata.tourLength_ << ")\n";
-        for(int u : vardata.tour_)
+        for(int u : vardata.getTour())
             os << u << " ";
         os << '\n';
         return os;
@@ -92,11 +100,29 @@ public:
     {
         return isElementary_;
     }
-//
-//    tourVRP getTourVRP()
-//    {
-//        return tourVrp_;
-//    }
+
+    /** travel costs of the tour */
+    SCIP_Real getObj() const
+    {
+        return obj_;
+    }
+
+    tour_view getTour() const
+    {
+        return {tour_, tourLength_};
+    }
+
+    /** copies the column into a (modifiable) tour */
+    void getTourVRP(
+        tourVRP&        tvrp
+    ) const
+    {
+        tvrp.tour_.assign(tour_, tour_ + tourLength_);
+        tvrp.length_ = tourLength_;
+        tvrp.capacity_ = capacity_;
+        tvrp.obj_ = obj_;
+        tvrp.setDay(day_);
+    }
 };
 
 bool SCIPcontainsTourVar(
@@ -114,5 +140,14 @@ SCIP_RETCODE SCIPcreateColumn(
         tourVRP&                tvrp
 );
 
+/** creates the columns of several priced tours at once; the cut coefficients of all tours are computed together
+ *  and added row by row */
+SCIP_RETCODE SCIPcreateColumns(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData,
+        vector<string>&         names,              /**< names of the columns, empty for generic names */
+        vector<tourVRP*>&       tours
+);
+
 
 #endif //VRP_VARDATA_H
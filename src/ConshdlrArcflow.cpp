@@ -206,28 +206,57 @@ SCIP_RETCODE checkVariable(
     return SCIP_OKAY;
 }
 
-/** fixes variables to zero if the corresponding tours are not valid for this constraint/node (due to branching) */
+/** checks the variables of a column list that were generated since the last propagation */
+static
+SCIP_RETCODE checkVariables(
+        SCIP*                 scip,               /**< SCIP data structure */
+        SCIP_CONSDATA*        consdata,           /**< constraint data */
+        vrp::ProbDataVRP*     probdata,           /**< problem data */
+        const vector<int>&    cols,               /**< sorted positions of the variables in the problem data */
+        int*                  nfixedvars,         /**< pointer to store the number of fixed variables */
+        SCIP_Bool*            cutoff              /**< pointer to store if a cutoff was detected */
+)
+{
+    for( auto it = lower_bound(cols.begin(), cols.end(), consdata->npropagatedvars);
+         it != cols.end() && *it < probdata->nVars_ && !(*cutoff); ++it )
+    {
+        SCIP_CALL( checkVariable(scip, consdata, probdata->vars_[*it], nfixedvars, cutoff) );
+    }
+    return SCIP_OKAY;
+}
+
+/** fixes variables to zero if the corresponding tours are not valid for this constraint/node (due to branching);
+ *  only the columns that visit the tail or the head are checked */
 static
 SCIP_RETCODE consdataFixVariables(
         SCIP*                 scip,               /**< SCIP data structure */
         SCIP_CONSDATA*        consdata,           /**< constraint data */
-        vector<SCIP_VAR*>&    vars,               /**< generated variables */
-        int                   nvars,              /**< number of generated variables */
+        vrp::ProbDataVRP*     probdata,           /**< problem data */
         SCIP_RESULT*          result              /**< pointer to store the result of the fixing */
 )
 {
     int nfixedvars;
-    int v;
     SCIP_Bool cutoff;
+    const column_index& index = probdata->columnIndex_;
 
     nfixedvars = 0;
     cutoff = FALSE;
 
-    SCIPdebugMsg(scip, "check variables %d to %d\n", consdata->npropagatedvars, nvars);
+    SCIPdebugMsg(scip, "check variables %d to %d\n", consdata->npropagatedvars, probdata->nVars_);
 
-    for( v = consdata->npropagatedvars; v < nvars && !cutoff; ++v )
+    if( consdata->type == PROHIBIT )
+    {
+        /* only columns using the arc are infeasible */
+        SCIP_CALL( checkVariables(scip, consdata, probdata, index.getArc(consdata->tail, consdata->head),
+                                  &nfixedvars, &cutoff) );
+    }
+    else
     {
-        SCIP_CALL( checkVariable(scip, consdata, vars[v], &nfixedvars, &cutoff) );
+        /* columns visiting the tail or the head without using the arc are infeasible */
+        if( consdata->tail != 0 )
+            SCIP_CALL( checkVariables(scip, consdata, probdata, index.getCustomer(consdata->tail), &nfixedvars, &cutoff) );
+        if( consdata->head != 0 )
+            SCIP_CALL( checkVariables(scip, consdata, probdata, index.getCustomer(consdata->head), &nfixedvars, &cutoff) );
     }
 
     SCIPdebugMsg(scip, "fixed %d variables locally\n", nfixedvars);
@@ -383,7 +412,7 @@ SCIP_DECL_CONSPROP(ConshdlrArcflow::scip_prop)
         {
             SCIPdebugMsg(scip, "propagate constraint <%s> ", SCIPconsGetName(conss[c]));
             SCIPdebug( consdataPrint(scip, consdata, nullptr) );
-            SCIP_CALL( consdataFixVariables(scip, consdata, probData->vars_, probData->nVars_, result) );
+            SCIP_CALL( consdataFixVariables(scip, consdata, probData, result) );
             consdata->npropagations++;
 
             if( *result != SCIP_CUTOFF )
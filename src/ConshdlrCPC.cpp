@@ -77,10 +77,10 @@ SCIP_RETCODE fixVariables(
         }
         SCIPchgVarLb(scip, var, 1.0);
         auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
-        int day = vardata->tourVrp_.getDay();
+        int day = vardata->getDay();
         if(probData->getData()->num_v[day] == 1)
             pricerData->fixedDay_[day] = true;
-        for(auto u : vardata->tourVrp_.tour_)
+        for(auto u : vardata->getTour())
         {
             pricerData->eC_[u] = day;
             for(int d = 0; d < probData->getData()->nDays; d++)
@@ -158,7 +158,7 @@ SCIP_RETCODE checkFixing(
 
         auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
         auto* obj = dynamic_cast<ObjPropTourVarFixing*>(SCIPgetObjProp(scip, SCIPfindProp(scip, "tourVarFixing")));
-        obj->tvrp_.copy(vardata->tourVrp_);
+        vardata->getTourVRP(obj->tvrp_);
         obj->obj_cmp_ = SCIPgetCutoffbound(scip);
 
         SCIP_Bool lperror, cutoff;
@@ -80,7 +80,7 @@ int customerAndDayInVar(
     auto* varData = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
     assert(varData != nullptr);
 
-    for(int u : varData->tour_)
+    for(int u : varData->getTour())
     {
         assert(u > 0);
         if(u == customer) // case 2
@@ -160,28 +160,55 @@ SCIP_RETCODE checkVariable(
     return SCIP_OKAY;
 }
 
-/** fixes variables to zero if the corresponding tours are not valid for this constraint/node (due to branching) */
+/** checks the variables of a column list that were generated since the last propagation */
+static
+SCIP_RETCODE checkVariables(
+        SCIP*                 scip,               /**< SCIP data structure */
+        SCIP_CONSDATA*        consdata,           /**< constraint data */
+        vrp::ProbDataVRP*     probdata,           /**< problem data */
+        const vector<int>&    cols,               /**< sorted positions of the variables in the problem data */
+        int*                  nfixedvars,         /**< pointer to store the number of fixed variables */
+        SCIP_Bool*            cutoff              /**< pointer to store if a cutoff was detected */
+)
+{
+    for( auto it = lower_bound(cols.begin(), cols.end(), consdata->npropagatedvars);
+         it != cols.end() && *it < probdata->nVars_ && !(*cutoff); ++it )
+    {
+        SCIP_CALL( checkVariable(scip, consdata, probdata->vars_[*it], nfixedvars, cutoff) );
+    }
+    return SCIP_OKAY;
+}
+
+/** fixes variables to zero if the corresponding tours are not valid for this constraint/node (due to branching);
+ *  only the columns that visit the customer or belong to the day are checked */
 static
 SCIP_RETCODE consdataFixVariables(
         SCIP*                 scip,               /**< SCIP data structure */
         SCIP_CONSDATA*        consdata,           /**< constraint data */
-        vector<SCIP_VAR*>&    vars,               /**< generated variables */
-        int                   nvars,              /**< number of generated variables */
+        vrp::ProbDataVRP*     probdata,           /**< problem data */
         SCIP_RESULT*          result              /**< pointer to store the result of the fixing */
 )
 {
     int nfixedvars;
-    int v;
     SCIP_Bool cutoff;
+    const column_index& index = probdata->columnIndex_;
 
     nfixedvars = 0;
     cutoff = FALSE;
 
-    SCIPdebugMsg(scip, "check variables %d to %d\n", consdata->npropagatedvars, nvars);
+    SCIPdebugMsg(scip, "check variables %d to %d\n", consdata->npropagatedvars, probdata->nVars_);
 
-    for( v = consdata->npropagatedvars; v < nvars && !cutoff; ++v )
+    if( consdata->type == PROHIBIT )
+    {
+        /* only columns visiting the customer on the day are infeasible */
+        SCIP_CALL( checkVariables(scip, consdata, probdata, index.getCustomerDay(consdata->customer, consdata->day),
+                                  &nfixedvars, &cutoff) );
+    }
+    else
     {
-        SCIP_CALL( checkVariable(scip, consdata, vars[v], &nfixedvars, &cutoff) );
+        /* columns visiting the customer on another day or the day without the customer are infeasible */
+        SCIP_CALL( checkVariables(scip, consdata, probdata, index.getCustomer(consdata->customer), &nfixedvars, &cutoff) );
+        SCIP_CALL( checkVariables(scip, consdata, probdata, index.getDay(consdata->day), &nfixedvars, &cutoff) );
     }
 
     SCIPdebugMsg(scip, "fixed %d variables locally\n", nfixedvars);
@@ -344,7 +371,7 @@ SCIP_DECL_CONSPROP(ConshdlrDayVar::scip_prop)
         {
             SCIPdebugMsg(scip, "propagate constraint <%s> ", SCIPconsGetName(conss[c]));
             SCIPdebug( consdataPrint(scip, consdata, nullptr) );
-            SCIP_CALL( consdataFixVariables(scip, consdata, probData->vars_, probData->nVars_, result) );
+            SCIP_CALL( consdataFixVariables(scip, consdata, probData, result) );
             consdata->npropagations++;
 
             if( *result != SCIP_CUTOFF )
@@ -545,7 +572,7 @@ SCIP_RETCODE SCIPconshdlrPerformPropagate(
             continue;
         if(!consdata->propagated)
         {
-            SCIP_CALL( consdataFixVariables(scip, consdata, probData->vars_, probData->nVars_, &result) );
+            SCIP_CALL( consdataFixVariables(scip, consdata, probData, &result) );
             consdata->npropagations++;
             consdata->propagated = TRUE;
             consdata->npropagatedvars = probData->nVars_;
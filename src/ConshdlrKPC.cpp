@@ -99,7 +99,7 @@ SCIP_RETCODE addVarsToCons(
     for(auto var : probData->vars_)
     {
         auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
-        tourVRP& tvrp = vardata->tourVrp_;
+        tour_view tvrp = vardata->getTour();
         if(tvrp.length_ == 0)
             continue;
         SCIP_Real value = 0.0;
@@ -127,26 +127,44 @@ bool needTwoRoutes(
         vector<bool>&       setS,
         vector<int>&        nodeList
 ){
-    int count;
     int setSize = (int) nodeList.size();
+    /* position of each customer of the set in nodeList and the arcs of the day between them (both directions) */
+    vector<int> posInSet(modelData->nC, -1);
+    for(int i = 0; i < setSize; i++)
+        posInSet[nodeList[i]] = i;
+    vector<bool> hasArc((size_t) setSize * setSize);
     for(int day = 0; day < modelData->nDays; day++)
     {
-        /* first check if every customer is available on that day */
-        count = 0;
-        for(auto v : modelData->neighbors[0][day])
+        /* first check if every customer is available on that day, i.e. reachable from the depot */
+        int nReachable = 0;
+        for(int v : modelData->neighbors[0][day])
         {
             if(setS[v])
-                count++;
+                nReachable++;
         }
-        if(count == (int) nodeList.size())
+        if(nReachable == setSize)
         {
+            /* one pass over the neighbors of the set instead of a search per pair */
+            hasArc.assign(hasArc.size(), false);
+            for(int i = 0; i < setSize; i++)
+            {
+                for(int v : modelData->neighbors[nodeList[i]][day])
+                {
+                    int j = posInSet[v];
+                    if(j >= 0)
+                    {
+                        hasArc[i * setSize + j] = true;
+                        hasArc[j * setSize + i] = true;
+                    }
+                }
+            }
             /* check if each pair of customers in nodeset has at least on arc */
             bool conflict = false;
             for(int i = 0; i < setSize; i++)
             {
                 for(int j = i + 1; j < setSize; j++)
                 {
-                    if(!modelData->adjacency_k[day][nodeList[i]][nodeList[j]] && !modelData->adjacency_k[day][nodeList[j]][nodeList[i]])
+                    if(!hasArc[i * setSize + j])
                     {
                         conflict = true;
                         break;
@@ -526,6 +544,32 @@ SCIP_RETCODE SCIPaddCoefKPC(
     return SCIP_OKAY;
 }
 
+/** adds the coefficients of several variables in k-path constraint at once */
+SCIP_RETCODE SCIPaddCoefsKPC(
+        SCIP*                 scip,               /**< SCIP data structure */
+        SCIP_CONS*            cons,               /**< constraint data */
+        int                   nvars,              /**< number of variables to add */
+        SCIP_VAR**            vars,               /**< variables to add to the constraint */
+        SCIP_Real*            vals                /**< coefficients of the constraint entries */
+)
+{
+    SCIP_CONSDATA* consdata;
+
+    if( strcmp(SCIPconshdlrGetName(SCIPconsGetHdlr(cons)), CONSHDLR_NAME3) != 0 )
+    {
+        SCIPerrorMessage("constraint is not a k-path constraint\n");
+        return SCIP_INVALIDDATA;
+    }
+
+    consdata = SCIPconsGetData(cons);
+    assert(consdata != nullptr);
+    assert(consdata->cut != nullptr);
+    SCIP_CALL( SCIPaddVarsToCutRow(scip, consdata->cut, &consdata->vars, &consdata->coeffs, &consdata->nvars,
+                                   &consdata->varssize, nvars, vars, vals) );
+
+    return SCIP_OKAY;
+}
+
 /** creates and adds the row of a k-path constraint to the LP */
 SCIP_RETCODE SCIPcreateAndAddRowKPC(
         SCIP*                   scip,
@@ -106,8 +106,8 @@ SCIP_RETCODE addVarsToCons( // TODO: adjust
     for(auto var : probData->vars_)
     {
         double value = 0.0;
-        tourVRP& tvrp = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var))->tourVrp_;
-        for(auto u : tvrp.tour_)
+        tour_view tvrp = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var))->getTour();
+        for(auto u : tvrp)
         {
             if(setS[u])
                 value += p;
@@ -267,9 +267,9 @@ SCIP_DECL_CONSSEPALP(ConshdlrSRC::scip_sepalp){
                     {
                         if(!SCIPisPositive(scip, SCIPvarGetLPSol(var)))
                             continue;
-                        tourVRP& tvrp = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var))->tourVrp_;
+                        tour_view tvrp = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var))->getTour();
                         double val = 0.0;
-                        for(auto u : tvrp.tour_)
+                        for(auto u : tvrp)
                         {
                             if(u == i || u == j || u == k)
                                 val++;
@@ -443,6 +443,32 @@ SCIP_RETCODE SCIPaddCoefSRC(
     return SCIP_OKAY;
 }
 
+/** adds the coefficients of several variables in subset row constraint at once */
+SCIP_RETCODE SCIPaddCoefsSRC(
+        SCIP*                 scip,               /**< SCIP data structure */
+        SCIP_CONS*            cons,               /**< constraint data */
+        int                   nvars,              /**< number of variables to add */
+        SCIP_VAR**            vars,               /**< variables to add to the constraint */
+        SCIP_Real*            vals                /**< coefficients of the constraint entries */
+)
+{
+    SCIP_CONSDATA* consdata;
+
+    if( strcmp(SCIPconshdlrGetName(SCIPconsGetHdlr(cons)), CONSHDLR_NAME4) != 0 )
+    {
+        SCIPerrorMessage("constraint is not a subset row constraint\n");
+        return SCIP_INVALIDDATA;
+    }
+
+    consdata = SCIPconsGetData(cons);
+    assert(consdata != nullptr);
+    assert(consdata->cut != nullptr);
+    SCIP_CALL( SCIPaddVarsToCutRow(scip, consdata->cut, &consdata->vars, &consdata->coeffs, &consdata->nvars,
+                                   &consdata->varssize, nvars, vars, vals) );
+
+    return SCIP_OKAY;
+}
+
 /** creates and adds the row of a subset row constraint to the LP */
 SCIP_RETCODE SCIPcreateAndAddRowSRC(
         SCIP*                   scip,
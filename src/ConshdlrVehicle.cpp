@@ -56,7 +56,7 @@ SCIP_RETCODE addVarsToRow(
     for(auto var : probData->vars_)
     {
         auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
-        if(vardata->tourVrp_.getDay() == day)
+        if(vardata->getDay() == day)
         {
             SCIP_CALL(SCIPaddVarToRow(scip, cut, var, 1.0));
         }
@@ -112,7 +112,7 @@ bool isVehicleConsViolated(
     for(auto* var : probData->vars_)
     {
         auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
-        if(vardata->tourVrp_.getDay() != consdata->day)
+        if(vardata->getDay() != consdata->day)
             continue;
         value += SCIPvarGetLPSol(var);
         if(SCIPisPositive(scip, SCIPvarGetLPSol(var)) && consdata->type == PROHIBIT)
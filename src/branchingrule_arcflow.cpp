@@ -43,7 +43,6 @@ SCIP_DECL_BRANCHEXECPS(ObjBranchruleArcflow::scip_execlp)
     auto* pricerData = dynamic_cast<ObjPricerVRP*>(SCIPfindObjPricer(scip_, "VRP_Pricer"));
     model_data* modelData = probData->getData();
     vector<vector<SCIP_Real>> arcweights(modelData->nC, vector<SCIP_Real>(modelData->nC));
-    vector<SCIP_VAR*> modelvars = probData->vars_;
 
     int narcs;
     int i, j;
@@ -35,8 +35,9 @@ SCIP_DECL_BRANCHEXECPS(ObjBranchruleVehicle::scip_execlp)
         cout << "Node "<< SCIPnodeGetNumber(SCIPgetCurrentNode(scip))
         << " solved, but still fractional - start: NUM VEHICLE BRANCHING!\n";
     }
-    for(auto* var : probData->vars_)
+    for(int c = 0; c < SCIPgetNLPCols(scip); c++)
     {
+        SCIP_VAR* var = SCIPcolGetVar(SCIPgetLPCols(scip)[c]);
         if(SCIPisPositive(scip, SCIPvarGetLPSol(var)))
         {
             auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
@@ -82,45 +82,17 @@ SCIP_DECL_EVENTEXEC(EventhdlrNodeInit::scip_exec) {  /*lint --e{715}*/
         SCIP_Bool fixed;
         SCIP_Bool infeasible;
         /* check if the (new) vars stand in conflict with the parents node data */
-        for(int i = nodeData.num_vars; i < probData->nVars_; i++)
+        vector<int> conflicts;
+        probData->columnIndex_.getConflicts(nodeData.node_isForbidden_, nodeData.node_timetable_, nodeData.num_vars,
+                                            conflicts);
+        for(int i : conflicts)
         {
-            fixed = FALSE;
+            /* also skips vars collected more than once */
             if(SCIPvarGetUbLocal(probData->vars_[i]) < 0.5)
                 continue;
-            auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, probData->vars_[i]));
-            tourVRP& tvrp = vardata->tourVrp_;
-            int day = vardata->getDay();
-//            for(auto v : vardata->tourVrp_.tour_)
-//            {
-//                if(!nodeData.node_timetable_[v][day])
-//                {
-//                    SCIP_CALL( SCIPfixVar(scip, probData->vars_[i], 0.0, &infeasible, &fixed) );
-//                    assert(!infeasible);
-//                    assert(fixed);
-//                    break;
-//                }
-//            }
-            if(nodeData.node_isForbidden_[tvrp.tour_[tvrp.length_-1]][0] || nodeData.node_isForbidden_[0][tvrp.tour_[0]]
-            || !nodeData.node_timetable_[tvrp.tour_[0]][day])
-                fixed = TRUE;
-            else
-            {
-                /* check inner arcs and rest of customers */
-                for(int v = 1; v < tvrp.length_; v++)
-                {
-                    if(!nodeData.node_timetable_[tvrp.tour_[v]][day] || nodeData.node_isForbidden_[tvrp.tour_[v-1]][tvrp.tour_[v]])
-                    {
-                        fixed = TRUE;
-                        break;
-                    }
-                }
-            }
-            if(fixed)
-            {
-                SCIP_CALL( SCIPfixVar(scip, probData->vars_[i], 0.0, &infeasible, &fixed) );
-                assert(!infeasible);
-                assert(fixed);
-            }
+            SCIP_CALL( SCIPfixVar(scip, probData->vars_[i], 0.0, &infeasible, &fixed) );
+            assert(!infeasible);
+            assert(fixed);
         }
 //        for(auto var : probData->vars_)
 //        {
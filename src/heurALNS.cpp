@@ -0,0 +1,496 @@
+
+#include <cmath>
+#include <random>
+
+#include "heurALNS.h"
+#include "probdata_vrp.h"
+#include "tools_vrp.h"
+
+#define ALNS_NDESTROY 4
+#define ALNS_NREPAIR 2
+#define ALNS_ROUTE_PENALTY 1e6 // insertion costs of opening a route if the number of vehicles is minimized
+
+/** value of a solution given by the tours of each vehicle */
+static
+SCIP_Real getSolutionValue(
+        model_data*             modelData,
+        vector<tourVRP>&        tours
+){
+    SCIP_Real value = 0.0;
+    for(auto& t : tours)
+    {
+        if(t.length_ == 0)
+            continue;
+        value += modelData->minTravel ? t.obj_ : 1.0;
+    }
+    return value;
+}
+
+/** removes the customer at pos from the tour if the tour stays feasible */
+static
+bool removeCustomer(
+        model_data*             modelData,
+        tourVRP&                tvrp,
+        int                     pos
+){
+    tourVRP tmp;
+    tmp.copy(tvrp);
+    tmp.obj_ += getDeleteCosts(modelData, tmp.tour_, tmp.length_, pos);
+    tmp.capacity_ -= modelData->demand[tmp.tour_[pos]];
+    tmp.tour_.erase(tmp.tour_.begin() + pos);
+    tmp.length_--;
+    if(tmp.length_ == 0)
+        tmp.obj_ = 0.0;
+    else if(!tmp.isFeasible(modelData))
+        return false;
+    tvrp.copy(tmp);
+    return true;
+}
+
+/** removes the customer from the solution if its tour stays feasible */
+static
+bool removeFromSolution(
+        model_data*             modelData,
+        vector<tourVRP>&        tours,
+        int                     cust
+){
+    for(auto& t : tours)
+    {
+        for(int i = 0; i < t.length_; i++)
+        {
+            if(t.tour_[i] == cust)
+                return removeCustomer(modelData, t, i);
+        }
+    }
+    return false;
+}
+
+/** destroy operators: random, worst (largest saving), related (closest to a random customer) and route removal */
+static
+void destroySolution(
+        model_data*             modelData,
+        vector<tourVRP>&        tours,
+        int                     op,
+        int                     nRemove,
+        mt19937&                rng,
+        vector<int>&            removed
+){
+    vector<int> custs;
+    for(auto& t : tours)
+        custs.insert(custs.end(), t.tour_.begin(), t.tour_.begin() + t.length_);
+    if(custs.empty())
+        return;
+
+    if(op == 0)
+    {
+        shuffle(custs.begin(), custs.end(), rng);
+    }else if(op == 1)
+    {
+        /* savings of the customers, perturbed to diversify the removal */
+        uniform_real_distribution<double> noise(0.8, 1.2);
+        vector<pair<int, double>> savings;
+        for(auto& t : tours)
+        {
+            for(int i = 0; i < t.length_; i++)
+                savings.emplace_back(t.tour_[i], -getDeleteCosts(modelData, t.tour_, t.length_, i) * noise(rng));
+        }
+        sort(savings.begin(), savings.end(), [](auto &left, auto &right){
+            return left.second > right.second;
+        });
+        for(int i = 0; i < (int) savings.size(); i++)
+            custs[i] = savings[i].first;
+    }else if(op == 2)
+    {
+        int seed = custs[rng() % custs.size()];
+        travel_matrix& tr = modelData->travel;
+        sort(custs.begin(), custs.end(), [&](int left, int right){
+            return tr[seed][left] + tr[left][seed] < tr[seed][right] + tr[right][seed];
+        });
+    }else
+    {
+        /* all customers of a random route */
+        vector<int> routes;
+        for(int v = 0; v < (int) tours.size(); v++)
+        {
+            if(tours[v].length_ > 0)
+                routes.push_back(v);
+        }
+        tourVRP& t = tours[routes[rng() % routes.size()]];
+        custs.assign(t.tour_.begin(), t.tour_.begin() + t.length_);
+        nRemove = t.length_;
+    }
+
+    for(auto cust : custs)
+    {
+        if((int) removed.size() >= nRemove)
+            break;
+        if(removeFromSolution(modelData, tours, cust))
+            removed.push_back(cust);
+    }
+}
+
+/** finds the cheapest and second cheapest insertion of a customer over all vehicles */
+static
+bool getBestInsertion(
+        SCIP_Real               sumepsilon,
+        model_data*             modelData,
+        vector<tourVRP>&        tours,
+        int                     cust,
+        int*                    bestVehicle,
+        double*                 bestCosts,
+        double*                 secondCosts
+){
+    tourVRP tmp;
+    *bestVehicle = -1;
+    *bestCosts = SCIP_DEFAULT_INFINITY;
+    *secondCosts = SCIP_DEFAULT_INFINITY;
+    for(auto v : modelData->availableVehicles[cust])
+    {
+        tourVRP& t = tours[v];
+        if(t.capacity_ + modelData->demand[cust] > modelData->max_caps[t.getDay()])
+            continue;
+        tmp.copy(t);
+        if(!tmp.addNode(modelData, nullptr, cust, sumepsilon))
+            continue;
+        double costs = tmp.obj_ - t.obj_;
+        if(!modelData->minTravel && t.length_ == 0)
+            costs += ALNS_ROUTE_PENALTY;
+        if(costs < *bestCosts)
+        {
+            *secondCosts = *bestCosts;
+            *bestCosts = costs;
+            *bestVehicle = v;
+        }else if(costs < *secondCosts)
+        {
+            *secondCosts = costs;
+        }
+    }
+    return *bestVehicle >= 0;
+}
+
+/** inserts a customer that fits nowhere at the cheapest exchange position, the displaced customer is returned */
+static
+int exchangeCustomer(
+        model_data*             modelData,
+        vector<tourVRP>&        tours,
+        int                     cust
+){
+    int bestVehicle = -1, bestPos = -1;
+    double bestCosts = SCIP_DEFAULT_INFINITY;
+    for(auto v : modelData->availableVehicles[cust])
+    {
+        tourVRP& t = tours[v];
+        for(int i = 0; i < t.length_; i++)
+        {
+            if(t.capacity_ + modelData->demand[cust] - modelData->demand[t.tour_[i]] > modelData->max_caps[t.getDay()])
+                continue;
+            double costs = getExchangeCosts(modelData, t.tour_, t.length_, cust, i);
+            if(costs >= bestCosts)
+                continue;
+            int oldCust = t.tour_[i];
+            t.tour_[i] = cust;
+            if(t.isFeasible(modelData))
+            {
+                bestVehicle = v;
+                bestPos = i;
+                bestCosts = costs;
+            }
+            t.tour_[i] = oldCust;
+        }
+    }
+    if(bestVehicle == -1)
+        return -1;
+    tourVRP& t = tours[bestVehicle];
+    int oldCust = t.tour_[bestPos];
+    t.tour_[bestPos] = cust;
+    t.obj_ += bestCosts;
+    t.capacity_ += modelData->demand[cust] - modelData->demand[oldCust];
+    return oldCust;
+}
+
+/** repair operators: greedy insertion in random order and regret-2 insertion
+ *
+ *  A customer without feasible insertion displaces the customer of its cheapest exchange position, which is inserted
+ *  again. Returns false if the removed customers cannot all be inserted.
+ */
+static
+bool repairSolution(
+        SCIP_Real               sumepsilon,
+        model_data*             modelData,
+        vector<tourVRP>&        tours,
+        int                     op,
+        mt19937&                rng,
+        vector<int>&            removed
+){
+    int vehicle, maxExchanges = 2 * (int) removed.size();
+    double costs, secondCosts;
+
+    if(op == 0)
+        shuffle(removed.begin(), removed.end(), rng);
+    while(!removed.empty())
+    {
+        int k = 0;
+        if(op == 1)
+        {
+            /* the customer with the largest difference between its best and second best insertion comes first */
+            double maxRegret = -1.0;
+            for(int i = 0; i < (int) removed.size(); i++)
+            {
+                if(!getBestInsertion(sumepsilon, modelData, tours, removed[i], &vehicle, &costs, &secondCosts))
+                {
+                    k = i;
+                    break;
+                }
+                if(secondCosts - costs > maxRegret)
+                {
+                    maxRegret = secondCosts - costs;
+                    k = i;
+                }
+            }
+        }
+        int cust = removed[k];
+        removed.erase(removed.begin() + k);
+        if(getBestInsertion(sumepsilon, modelData, tours, cust, &vehicle, &costs, &secondCosts))
+        {
+            tours[vehicle].addNode(modelData, nullptr, cust, sumepsilon);
+            continue;
+        }
+        if(maxExchanges-- == 0)
+            return false;
+        int oldCust = exchangeCustomer(modelData, tours, cust);
+        if(oldCust < 0)
+            return false;
+        removed.push_back(oldCust);
+    }
+    return true;
+}
+
+/** selects an operator with probability proportional to its weight */
+static
+int selectOperator(
+        vector<double>&         weights,
+        mt19937&                rng
+){
+    discrete_distribution<int> dist(weights.begin(), weights.end());
+    return dist(rng);
+}
+
+static
+void *alns_thread(void *arguments){
+    static_cast<HeurALNS*>(arguments)->run();
+    return nullptr;
+}
+
+SCIP_DECL_HEURINITSOL(HeurALNS::scip_initsol)
+{
+    best_ = SCIPinfinity(scip);
+    lastSol_ = nullptr;
+    if(SCIPheurGetFreq(heur) < 0 || isRunning_)
+        return SCIP_OKAY;
+
+    modelData_ = *dynamic_cast<vrp::ProbDataVRP*>(SCIPgetObjProbData(scip_))->getData();
+    sumepsilon_ = SCIPsumepsilon(scip);
+    stop_ = false;
+    newIncumbent_ = false;
+    incumbent_.clear();
+    sol_tours_.clear();
+    if(pthread_create(&thread_, nullptr, alns_thread, this) != 0)
+    {
+        SCIPerrorMessage("could not start the ALNS thread\n");
+        return SCIP_ERROR;
+    }
+    isRunning_ = true;
+
+    return SCIP_OKAY;
+}
+
+SCIP_DECL_HEUREXITSOL(HeurALNS::scip_exitsol)
+{
+    if(!isRunning_)
+        return SCIP_OKAY;
+
+    pthread_mutex_lock(&mutex_);
+    stop_ = true;
+    pthread_cond_signal(&cond_);
+    pthread_mutex_unlock(&mutex_);
+    pthread_join(thread_, nullptr);
+    isRunning_ = false;
+
+    return SCIP_OKAY;
+}
+
+/** execution method of primal heuristic */
+SCIP_DECL_HEUREXEC(HeurALNS::scip_exec)
+{
+    /* the solutions are exchanged by the pricer, which can add their columns */
+    *result = SCIP_DIDNOTRUN;
+
+    return SCIP_OKAY;
+}
+
+void HeurALNS::setIncumbent(
+        vector<tourVRP>&        tours
+){
+    model_data* modelData = &modelData_;
+    vector<tourVRP> vehicleTours;
+    vector<int> nextVehicle(modelData->firstVehicleofday.begin(), modelData->firstVehicleofday.end() - 1);
+
+    for(int v = 0; v < modelData->nVehicles; v++)
+        vehicleTours.emplace_back(0, modelData->dayofVehicle[v]);
+    for(auto& t : tours)
+    {
+        int day = t.getDay();
+        if(t.length_ == 0)
+            continue;
+        if(nextVehicle[day] == modelData->firstVehicleofday[day + 1])
+            return;
+        tourVRP& vehicleTour = vehicleTours[nextVehicle[day]++];
+        vehicleTour.copy(t);
+        vehicleTour.setValues(modelData);
+    }
+
+    pthread_mutex_lock(&mutex_);
+    incumbent_ = vehicleTours;
+    newIncumbent_ = true;
+    pthread_cond_signal(&cond_);
+    pthread_mutex_unlock(&mutex_);
+}
+
+bool HeurALNS::getSolution(
+        SCIP*                   scip,
+        vector<tourVRP>&        tours,
+        SCIP_Real               upperbound
+){
+    bool found = false;
+    pthread_mutex_lock(&mutex_);
+    if(SCIPisSumNegative(scip, best_ - upperbound))
+    {
+        tours = sol_tours_;
+        found = true;
+    }
+    pthread_mutex_unlock(&mutex_);
+    return found;
+}
+
+void HeurALNS::run()
+{
+    model_data* modelData = &modelData_;
+    mt19937 rng(0);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    vector<tourVRP> current, best, candidate;
+    vector<int> removed;
+    SCIP_Real currentObj = SCIP_DEFAULT_INFINITY, bestObj = SCIP_DEFAULT_INFINITY;
+    double temperature = 0.0;
+    int nSegmentsNoImprove = 0;
+
+    /* adaptive weights of the operators (Ropke and Pisinger): the scores of a segment are 33 for a new best solution,
+     * 9 for an improvement of the current one and 13 for an accepted worse one */
+    vector<double> destroyWeights(ALNS_NDESTROY, 1.0), repairWeights(ALNS_NREPAIR, 1.0);
+    vector<double> destroyScores(ALNS_NDESTROY), repairScores(ALNS_NREPAIR);
+    vector<int> destroyUses(ALNS_NDESTROY), repairUses(ALNS_NREPAIR);
+    const double reaction = 0.1;
+
+    pthread_mutex_lock(&mutex_);
+    while(!stop_)
+    {
+        /* continue from the incumbent of SCIP if it is better */
+        if(newIncumbent_)
+        {
+            newIncumbent_ = false;
+            SCIP_Real incumbentObj = getSolutionValue(modelData, incumbent_);
+            if(incumbentObj < bestObj - 1e-6)
+            {
+                current = incumbent_;
+                best = incumbent_;
+                currentObj = incumbentObj;
+                bestObj = incumbentObj;
+                temperature = 0.01 * bestObj;
+                nSegmentsNoImprove = 0;
+            }
+        }
+        if(current.empty() || nSegmentsNoImprove >= ALNS_MAX_NOIMPROVE)
+        {
+            pthread_cond_wait(&cond_, &mutex_);
+            continue;
+        }
+        pthread_mutex_unlock(&mutex_);
+
+        bool improved = false;
+        fill(destroyScores.begin(), destroyScores.end(), 0.0);
+        fill(repairScores.begin(), repairScores.end(), 0.0);
+        fill(destroyUses.begin(), destroyUses.end(), 0);
+        fill(repairUses.begin(), repairUses.end(), 0);
+        for(int iter = 0; iter < ALNS_SEGMENT && !stop_; iter++)
+        {
+            int destroyOp = selectOperator(destroyWeights, rng);
+            int repairOp = selectOperator(repairWeights, rng);
+            int maxRemove = max(2, (modelData->nC - 1) * 3 / 10);
+            int nRemove = min(modelData->nC - 1, 2 + (int) (rng() % (maxRemove - 1)));
+            destroyUses[destroyOp]++;
+            repairUses[repairOp]++;
+
+            candidate = current;
+            removed.clear();
+            destroySolution(modelData, candidate, destroyOp, nRemove, rng, removed);
+            if(!repairSolution(sumepsilon_, modelData, candidate, repairOp, rng, removed))
+                continue;
+
+            double score = 0.0;
+            SCIP_Real candidateObj = getSolutionValue(modelData, candidate);
+            if(candidateObj < currentObj - 1e-6)
+            {
+                score = 9.0;
+                if(candidateObj < bestObj - 1e-6)
+                {
+                    score = 33.0;
+                    best = candidate;
+                    bestObj = candidateObj;
+                    improved = true;
+                }
+            }else if(temperature > 0.0 && uniform(rng) < exp((currentObj - candidateObj) / temperature))
+            {
+                score = 13.0;
+            }
+            if(score > 0.0)
+            {
+                current.swap(candidate);
+                currentObj = candidateObj;
+            }
+            destroyScores[destroyOp] += score;
+            repairScores[repairOp] += score;
+            temperature *= 0.9995;
+        }
+        for(int i = 0; i < ALNS_NDESTROY; i++)
+        {
+            if(destroyUses[i] > 0)
+                destroyWeights[i] = (1 - reaction) * destroyWeights[i] + reaction * destroyScores[i] / destroyUses[i];
+            destroyWeights[i] = max(destroyWeights[i], 0.01);
+        }
+        for(int i = 0; i < ALNS_NREPAIR; i++)
+        {
+            if(repairUses[i] > 0)
+                repairWeights[i] = (1 - reaction) * repairWeights[i] + reaction * repairScores[i] / repairUses[i];
+            repairWeights[i] = max(repairWeights[i], 0.01);
+        }
+        nSegmentsNoImprove = improved ? 0 : nSegmentsNoImprove + 1;
+
+        /* the travel times of the tours are recomputed, the insertions only add up the differences */
+        if(improved)
+        {
+            for(auto& t : best)
+            {
+                if(t.length_ > 0)
+                    t.setValues(modelData);
+            }
+            bestObj = getSolutionValue(modelData, best);
+        }
+
+        pthread_mutex_lock(&mutex_);
+        if(improved)
+        {
+            sol_tours_ = best;
+            best_ = bestObj;
+        }
+    }
+    pthread_mutex_unlock(&mutex_);
+}
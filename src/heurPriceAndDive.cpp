@@ -0,0 +1,300 @@
+#include "heurPriceAndDive.h"
+#include "probdata_vrp.h"
+#include "pricer_vrp.h"
+#include "vardata.h"
+#include "var_tools.h"
+
+/** fixing of one probing node of the dive */
+typedef struct dive_decision {
+    SCIP_VAR*       var;            /**< fixed tour variable, nullptr for a customer-day assignment */
+    int             customer;       /**< customer of the assignment */
+    int             day;            /**< day of the assignment */
+    bool            isNegated;      /**< the variable is fixed to zero or the customer is prohibited on the day */
+} dive_decision;
+
+HeurPriceAndDive::HeurPriceAndDive(
+        SCIP*   scip
+):
+ObjHeur(scip, "priceAndDive", "diving with column generation along the dive", 'P', -1000000, 0, 0, -1,
+        SCIP_HEURTIMING_AFTERNODE, false),
+maxBacktracks_(3),
+maxPriceRounds_(-1)
+{
+    SCIPaddIntParam(scip, "heuristics/priceAndDive/maxbacktracks", "maximal number of backtracks of a dive",
+                    &maxBacktracks_, FALSE, 3, 0, INT_MAX, nullptr, nullptr);
+    SCIPaddIntParam(scip, "heuristics/priceAndDive/maxpricerounds", "maximal number of pricing rounds for each LP of "
+                    "the dive (-1: unlimited)", &maxPriceRounds_, FALSE, -1, -1, INT_MAX, nullptr, nullptr);
+}
+
+/** checks if all tour variables have an integral LP value */
+static
+bool isLPIntegral(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData
+){
+    for(auto* var : probData->vars_)
+    {
+        if(SCIPisPositive(scip, SCIPvarGetLPSol(var)) && SCIPisSumNegative(scip, SCIPvarGetLPSol(var) - 1))
+            return false;
+    }
+    return true;
+}
+
+/** selects the unfixed tour variable or customer-day assignment with the largest fractional LP value, tours are
+ *  preferred on ties */
+static
+SCIP_RETCODE selectDecision(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData,
+        dive_decision&          decision,
+        bool*                   found
+){
+    model_data* modelData = probData->getData();
+    SCIP_Real bestVal = 0.0;
+    SCIP_Real lpval;
+
+    decision.var = nullptr;
+    decision.customer = -1;
+    decision.day = -1;
+    decision.isNegated = false;
+
+    for(auto* var : probData->vars_)
+    {
+        if(SCIPvarGetLbLocal(var) > 0.5 || SCIPvarGetUbLocal(var) < 0.5)
+            continue;
+        lpval = SCIPvarGetLPSol(var);
+        if(lpval <= bestVal || !SCIPisSumNegative(scip, lpval - 1))
+            continue;
+        auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
+        if(vardata->getLength() == 0)
+            continue;
+        bestVal = lpval;
+        decision.var = var;
+    }
+
+    /* customers that are split over several days */
+    vector<vector<SCIP_Real>> valOnDay(modelData->nC, vector<SCIP_Real>(modelData->nDays));
+    vector<int> numOfDays(modelData->nC);
+    SCIP_CALL( getVehiAssValues(scip, valOnDay, numOfDays) );
+    for(int cust = 1; cust < modelData->nC; cust++)
+    {
+        if(numOfDays[cust] <= 1)
+            continue;
+        for(int day : modelData->availableDays[cust])
+        {
+            if(valOnDay[cust][day] > bestVal && SCIPisSumNegative(scip, valOnDay[cust][day] - 1))
+            {
+                bestVal = valOnDay[cust][day];
+                decision.var = nullptr;
+                decision.customer = cust;
+                decision.day = day;
+            }
+        }
+    }
+
+    *found = SCIPisPositive(scip, bestVal);
+    return SCIP_OKAY;
+}
+
+/** fixes a column to zero at the current probing node if it is not fixed yet */
+static
+SCIP_RETCODE fixColumnToZero(
+        SCIP*                   scip,
+        SCIP_VAR*               var
+){
+    if(SCIPvarGetLbLocal(var) < 0.5 && SCIPvarGetUbLocal(var) > 0.5)
+    {
+        SCIP_CALL( SCIPchgVarUbProbing(scip, var, 0.0) );
+    }
+    return SCIP_OKAY;
+}
+
+/** changes the bounds of the columns according to the decision at the current probing node */
+static
+SCIP_RETCODE applyDecision(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData,
+        ObjPricerVRP*           pricerData,
+        dive_decision&          decision
+){
+    model_data* modelData = probData->getData();
+    const column_index& columnIndex = probData->columnIndex_;
+
+    if(decision.var != nullptr)
+    {
+        auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, decision.var));
+        if(decision.isNegated)
+        {
+            SCIP_CALL( SCIPchgVarUbProbing(scip, decision.var, 0.0) );
+            /* the pricing must not generate the tour again */
+            vardata->getTourVRP(pricerData->diveExcludedTour_);
+            return SCIP_OKAY;
+        }
+        SCIP_CALL( SCIPchgVarLbProbing(scip, decision.var, 1.0) );
+        /* the other columns visiting a customer of the tour are not needed anymore */
+        for(int u : vardata->getTour())
+        {
+            for(int col : columnIndex.getCustomer(u))
+            {
+                if(probData->vars_[col] != decision.var)
+                {
+                    SCIP_CALL( fixColumnToZero(scip, probData->vars_[col]) );
+                }
+            }
+        }
+    }else if(decision.isNegated)
+    {
+        for(int col : columnIndex.getCustomerDay(decision.customer, decision.day))
+        {
+            SCIP_CALL( fixColumnToZero(scip, probData->vars_[col]) );
+        }
+    }else
+    {
+        for(int day : modelData->availableDays[decision.customer])
+        {
+            if(day == decision.day)
+                continue;
+            for(int col : columnIndex.getCustomerDay(decision.customer, day))
+            {
+                SCIP_CALL( fixColumnToZero(scip, probData->vars_[col]) );
+            }
+        }
+    }
+    return SCIP_OKAY;
+}
+
+/** restricts the timetable of the pricing to the decisions of the dive: the customers of fixed tours are not visited by
+ *  new tours anymore, assigned customers are only visited on their day */
+static
+SCIP_RETCODE updatePricingTimetable(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData,
+        ObjPricerVRP*           pricerData,
+        const bit_matrix&       nodeTimetable,
+        vector<dive_decision>&  decisions
+){
+    bit_matrix timetable = nodeTimetable;
+
+    for(auto& decision : decisions)
+    {
+        if(decision.var != nullptr)
+        {
+            if(decision.isNegated)
+                continue;
+            auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, decision.var));
+            for(int u : vardata->getTour())
+                timetable.resetRow(u);
+        }else if(decision.isNegated)
+        {
+            timetable[decision.customer][decision.day] = false;
+        }else
+        {
+            bool isAvailable = timetable[decision.customer][decision.day];
+            timetable.resetRow(decision.customer);
+            timetable[decision.customer][decision.day] = isAvailable;
+        }
+    }
+    SCIP_CALL( pricerData->setDiveTimetable(probData->getData(), timetable) );
+
+    return SCIP_OKAY;
+}
+
+/** probes the last decision on a new probing node and solves its LP with column generation */
+static
+SCIP_RETCODE probeDecision(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData,
+        ObjPricerVRP*           pricerData,
+        const bit_matrix&       nodeTimetable,
+        vector<dive_decision>&  decisions,
+        int                     maxPriceRounds,
+        bool*                   infeasible
+){
+    SCIP_Bool lperror, cutoff;
+
+    SCIP_CALL( SCIPnewProbingNode(scip) );
+    SCIP_CALL( applyDecision(scip, probData, pricerData, decisions.back()) );
+    SCIP_CALL( updatePricingTimetable(scip, probData, pricerData, nodeTimetable, decisions) );
+    SCIP_CALL( SCIPsolveProbingLPWithPricing(scip, FALSE, FALSE, maxPriceRounds, &lperror, &cutoff) );
+
+    *infeasible = lperror || cutoff || SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL ||
+                  SCIPisGE(scip, SCIPgetLPObjval(scip), SCIPgetCutoffbound(scip));
+
+    return SCIP_OKAY;
+}
+
+/** execution method of primal heuristic */
+SCIP_DECL_HEUREXEC(HeurPriceAndDive::scip_exec)
+{
+    vector<dive_decision> decisions;
+    dive_decision decision;
+    SCIP_SOL* sol = nullptr;
+    bool found;
+    bool infeasible = false;
+    int nBacktracks = 0;
+    bool hasNegatedTour = false;
+
+    *result = SCIP_DIDNOTRUN;
+    if(SCIPinProbing(scip) || nodeinfeasible)
+        return SCIP_OKAY;
+    if(SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL)
+        return SCIP_OKAY;
+
+    auto* probData = dynamic_cast<vrp::ProbDataVRP*>(SCIPgetObjProbData(scip_));
+    auto* pricerData = dynamic_cast<ObjPricerVRP*>(SCIPfindObjPricer(scip_, "VRP_Pricer"));
+    model_data* modelData = probData->getData();
+
+    if(isLPIntegral(scip, probData))
+        return SCIP_OKAY;
+
+    *result = SCIP_DIDNOTFIND;
+
+    SCIP_CALL( pricerData->startDive() );
+    bit_matrix nodeTimetable = pricerData->timetable_;
+    SCIP_CALL( SCIPstartProbing(scip) );
+
+    while(!SCIPisStopped(scip))
+    {
+        if(isLPIntegral(scip, probData))
+        {
+            SCIP_CALL( SCIPcreateSol(scip, &sol, heur) );
+            SCIP_CALL( SCIPlinkLPSol(scip, sol) );
+            SCIP_CALL( SCIPunlinkSol(scip, sol) );
+            break;
+        }
+
+        SCIP_CALL( selectDecision(scip, probData, decision, &found) );
+        if(!found)
+            break;
+        decisions.push_back(decision);
+        SCIP_CALL( probeDecision(scip, probData, pricerData, nodeTimetable, decisions, maxPriceRounds_, &infeasible) );
+
+        /* revert the last decision and probe its negation instead; the labeling can only exclude one tour, so a
+         * tour is negated at most once per dive */
+        if(infeasible && nBacktracks < maxBacktracks_ && (decisions.back().var == nullptr || !hasNegatedTour))
+        {
+            nBacktracks++;
+            if(decisions.back().var != nullptr)
+                hasNegatedTour = true;
+            decisions.back().isNegated = true;
+            SCIP_CALL( SCIPbacktrackProbing(scip, SCIPgetProbingDepth(scip) - 1) );
+            SCIP_CALL( probeDecision(scip, probData, pricerData, nodeTimetable, decisions, maxPriceRounds_,
+                                     &infeasible) );
+        }
+        if(infeasible)
+            break;
+    }
+
+    SCIP_CALL( SCIPendProbing(scip) );
+    SCIP_CALL( pricerData->endDive(modelData) );
+
+    if(sol != nullptr)
+    {
+        SCIP_Bool stored;
+        SCIP_CALL( SCIPtrySolFree(scip, &sol, false, false, false, false, true, &stored) );
+        if(stored)
+            *result = SCIP_FOUNDSOL;
+    }
+
+    return SCIP_OKAY;
+}
@@ -0,0 +1,244 @@
+
+#include "heurRestrictedMaster.h"
+#include "probdata_vrp.h"
+#include "vardata.h"
+#include "ConshdlrNVehicle.h"
+#include "ConshdlrVehicle.h"
+#include "scip/scipdefplugins.h"
+#include "scip/cons_setppc.h"
+#include "scip/cons_linear.h"
+
+HeurRestrictedMaster::HeurRestrictedMaster(
+        SCIP*   scip
+):
+ObjHeur(scip, "restrictedMaster", "set partitioning MIP over the generated columns", 'M', -1100000, 5, 0, -1,
+        SCIP_HEURTIMING_AFTERNODE, true),
+nodeLimit_(1000),
+timeLimit_(10.0),
+minNewCols_(0.2),
+lastNCols_(0),
+nPoolTours_(0),
+best_(SCIPinfinity(scip))
+{
+    SCIPaddIntParam(scip, "heuristics/restrictedMaster/nodelimit", "node limit of the sub-SCIP", &nodeLimit_, FALSE,
+                    1000, 1, INT_MAX, nullptr, nullptr);
+    SCIPaddRealParam(scip, "heuristics/restrictedMaster/timelimit", "time limit of the sub-SCIP", &timeLimit_, FALSE,
+                     10.0, 0.0, SCIP_REAL_MAX, nullptr, nullptr);
+    SCIPaddRealParam(scip, "heuristics/restrictedMaster/minnewcols", "relative number of new columns and tours since "
+                     "the last call needed to run again", &minNewCols_, FALSE, 0.2, 0.0, SCIP_REAL_MAX, nullptr, nullptr);
+}
+
+SCIP_DECL_HEURINITSOL(HeurRestrictedMaster::scip_initsol)
+{
+    lastNCols_ = 0;
+    nPoolTours_ = 0;
+    toursPool_.clear();
+    best_ = SCIPinfinity(scip);
+    sol_tours_.clear();
+
+    return SCIP_OKAY;
+}
+
+void HeurRestrictedMaster::addPoolTour(
+        model_data*             modelData,
+        tourVRP&                tvrp
+){
+    /* the columns of the partitioning MIP have to be elementary */
+    vector<bool> isVisited(modelData->nC, false);
+    for(int i = 0; i < tvrp.length_; i++)
+    {
+        if(isVisited[tvrp.tour_[i]])
+            return;
+        isVisited[tvrp.tour_[i]] = true;
+    }
+    toursPool_.push_back(tvrp);
+    if((int) toursPool_.size() > RESTRICTED_MASTER_POOL_SIZE)
+        toursPool_.pop_front();
+    nPoolTours_++;
+}
+
+/** execution method of primal heuristic */
+SCIP_DECL_HEUREXEC(HeurRestrictedMaster::scip_exec)
+{
+    SCIP* subscip;
+    SCIP_Real timelimit;
+    int k;
+
+    *result = SCIP_DIDNOTRUN;
+    if(SCIPinProbing(scip) || nodeinfeasible)
+        return SCIP_OKAY;
+
+    auto* probData = dynamic_cast<vrp::ProbDataVRP*>(SCIPgetObjProbData(scip_));
+    model_data* modelData = probData->getData();
+
+    /* only run again if enough new columns were generated */
+    int nCols = probData->nVars_ + nPoolTours_;
+    if(nCols < (1.0 + minNewCols_) * lastNCols_)
+        return SCIP_OKAY;
+    lastNCols_ = nCols;
+
+    SCIP_CALL( SCIPgetRealParam(scip, "limits/time", &timelimit) );
+    timelimit = min(timeLimit_, timelimit - SCIPgetSolvingTime(scip));
+    if(timelimit <= 1.0)
+        return SCIP_OKAY;
+
+    *result = SCIP_DIDNOTFIND;
+
+    SCIP_CALL( SCIPcreate(&subscip) );
+    SCIP_CALL( SCIPincludeDefaultPlugins(subscip) );
+    SCIP_CALL( SCIPcreateProbBasic(subscip, "restrictedMaster") );
+    SCIPsetMessagehdlrQuiet(subscip, TRUE);
+    SCIP_CALL( SCIPsetLongintParam(subscip, "limits/nodes", nodeLimit_) );
+    SCIP_CALL( SCIPsetRealParam(subscip, "limits/time", timelimit) );
+    /* only improving solutions are of interest */
+    if(!SCIPisInfinity(scip, SCIPgetPrimalbound(scip)))
+    {
+        SCIP_CALL( SCIPsetObjlimit(subscip, SCIPgetPrimalbound(scip)) );
+    }
+
+    /* each customer is visited exactly once and each day has its number of vehicles */
+    vector<SCIP_CONS*> conss(modelData->nC - 1 + modelData->nDays);
+    char name[SCIP_MAXSTRLEN];
+    for(k = 0; k < modelData->nC - 1; k++)
+    {
+        (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "customer_%d", k + 1);
+        SCIP_CALL( SCIPcreateConsBasicSetpart(subscip, &conss[k], name, 0, nullptr) );
+    }
+    for(int day = 0; day < modelData->nDays; day++)
+    {
+        (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "day_%d", day);
+        SCIP_CALL( SCIPcreateConsBasicLinear(subscip, &conss[modelData->nC - 1 + day], name, 0, nullptr, nullptr,
+                                             -SCIPinfinity(subscip), modelData->num_v[day]) );
+    }
+
+    /* the total number of vehicles and the active vehicle branching decisions of the master problem */
+    SCIP_CONS* vehicleCons;
+    SCIP_CALL( SCIPcreateConsBasicLinear(subscip, &vehicleCons, "vehicles", 0, nullptr, nullptr, -SCIPinfinity(subscip),
+                                         modelData->nVehicles) );
+    conss.push_back(vehicleCons);
+    SCIP_CONSHDLR* conshdlr = SCIPfindConshdlr(scip, "nVehicle");
+    for(k = 0; conshdlr != nullptr && k < SCIPconshdlrGetNConss(conshdlr); k++)
+    {
+        SCIP_CONS* cons = SCIPconshdlrGetConss(conshdlr)[k];
+        if(!SCIPconsIsActive(cons))
+            continue;
+        double numV = SCIPgetnumVOfNVehicleCons(cons);
+        bool isEnforced = SCIPgetTypeOfNVehicleCons(cons) == ENFORCE;
+        SCIP_CALL( SCIPcreateConsBasicLinear(subscip, &vehicleCons, SCIPconsGetName(cons), 0, nullptr, nullptr,
+                                             isEnforced ? numV : -SCIPinfinity(subscip),
+                                             isEnforced ? SCIPinfinity(subscip) : numV) );
+        conss.push_back(vehicleCons);
+    }
+    int firstVehicleCons = (int) conss.size();
+    vector<int> dayOfCons;
+    conshdlr = SCIPfindConshdlr(scip, "Vehicle");
+    for(k = 0; conshdlr != nullptr && k < SCIPconshdlrGetNConss(conshdlr); k++)
+    {
+        SCIP_CONS* cons = SCIPconshdlrGetConss(conshdlr)[k];
+        if(!SCIPconsIsActive(cons))
+            continue;
+        double usage = SCIPgetTypeOfVehicleCons(cons) == ENFORCE ? 1.0 : 0.0;
+        SCIP_CALL( SCIPcreateConsBasicLinear(subscip, &vehicleCons, SCIPconsGetName(cons), 0, nullptr, nullptr, usage,
+                                             usage) );
+        conss.push_back(vehicleCons);
+        dayOfCons.push_back(SCIPgetDayOfVehicleCons(cons));
+    }
+
+    /* columns of the master problem and tours of the pool, the master variable is nullptr for the latter */
+    vector<SCIP_VAR*> subvars;
+    vector<SCIP_VAR*> masterVars;
+    vector<tourVRP> tours;
+    tourVRP tvrp;
+    for(auto* var : probData->vars_)
+    {
+        if(SCIPvarGetUbGlobal(var) < 0.5)
+            continue;
+        auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
+        if(!vardata->isElementary() || vardata->getLength() == 0)
+            continue;
+        vardata->getTourVRP(tvrp);
+        tours.push_back(tvrp);
+        masterVars.push_back(var);
+    }
+    for(auto& t : toursPool_)
+    {
+        SCIP_Var* existingVar = nullptr;
+        if(SCIPcontainsTourVar(scip, probData, &existingVar, t))
+            continue;
+        tours.push_back(t);
+        masterVars.push_back(nullptr);
+    }
+    subvars.resize(tours.size());
+    for(k = 0; k < (int) tours.size(); k++)
+    {
+        tourVRP& t = tours[k];
+        SCIP_Real obj = masterVars[k] != nullptr ? SCIPvarGetObj(masterVars[k]) : (modelData->minTravel ? t.obj_ : 1.0);
+        SCIP_CALL( SCIPcreateVarBasic(subscip, &subvars[k], nullptr, 0.0, 1.0, obj, SCIP_VARTYPE_BINARY) );
+        SCIP_CALL( SCIPaddVar(subscip, subvars[k]) );
+        for(int i = 0; i < t.length_; i++)
+        {
+            SCIP_CALL( SCIPaddCoefSetppc(subscip, conss[t.tour_[i] - 1], subvars[k]) );
+        }
+        SCIP_CALL( SCIPaddCoefLinear(subscip, conss[modelData->nC - 1 + t.getDay()], subvars[k], 1.0) );
+        for(int c = modelData->nC - 1 + modelData->nDays; c < firstVehicleCons; c++)
+        {
+            SCIP_CALL( SCIPaddCoefLinear(subscip, conss[c], subvars[k], 1.0) );
+        }
+        for(int c = firstVehicleCons; c < (int) conss.size(); c++)
+        {
+            if(dayOfCons[c - firstVehicleCons] == t.getDay())
+            {
+                SCIP_CALL( SCIPaddCoefLinear(subscip, conss[c], subvars[k], 1.0) );
+            }
+        }
+    }
+    for(auto* cons : conss)
+    {
+        SCIP_CALL( SCIPaddCons(subscip, cons) );
+        SCIP_CALL( SCIPreleaseCons(subscip, &cons) );
+    }
+
+    SCIP_CALL( SCIPsolve(subscip) );
+
+    if(SCIPgetNSols(subscip) > 0)
+    {
+        SCIP_SOL* subsol = SCIPgetBestSol(subscip);
+        SCIP_SOL* sol;
+        bool hasNewCols = false;
+        vector<tourVRP> solTours;
+
+        SCIP_CALL( SCIPcreateSol(scip, &sol, heur) );
+        for(k = 0; k < (int) tours.size(); k++)
+        {
+            if(SCIPgetSolVal(subscip, subsol, subvars[k]) < 0.5)
+                continue;
+            solTours.push_back(tours[k]);
+            if(masterVars[k] != nullptr)
+            {
+                SCIP_CALL( SCIPsetSolVal(scip, sol, masterVars[k], 1.0) );
+            }else
+                hasNewCols = true;
+        }
+        if(!hasNewCols)
+        {
+            SCIP_Bool stored;
+            SCIP_CALL( SCIPtrySolFree(scip, &sol, false, false, false, false, false, &stored) );
+            if(stored)
+                *result = SCIP_FOUNDSOL;
+        }else
+        {
+            /* the columns of the pool tours are added by the pricer */
+            SCIP_CALL( SCIPfreeSol(scip, &sol) );
+            best_ = SCIPgetSolOrigObj(subscip, subsol);
+            sol_tours_ = solTours;
+        }
+    }
+
+    for(auto* subvar : subvars)
+    {
+        SCIP_CALL( SCIPreleaseVar(subscip, &subvar) );
+    }
+    SCIP_CALL( SCIPfree(&subscip) );
+
+    return SCIP_OKAY;
+}
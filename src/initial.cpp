@@ -10,15 +10,12 @@ using namespace std;
 
 static
 int getTimeWindowSum(
-        vector<timeWindow> &tws
+        customer_day_table<timeWindow>::row_ref tws
 ){
     int sum = 0;
-    for(auto tw: tws)
+    for(auto& tw: tws)
     {
-        if(tw.end > 0)
-        {
-            sum += (tw.end - tw.start);
-        }
+        sum += (tw.end - tw.start);
     }
     return sum;
 }
@@ -1,101 +1,114 @@
-
 #include "label2.h"
 #include "scip/scip.h"
 #include "model_data.h"
 
 
-Label2* label_propagate2(
-        model_data*     modelData,
+void label_extend_all(
+        model_data*         modelData,
+        Label2*             old_label,
+        arc_table&          arcs,
+        int                 day,
+        vector<double>&     newTimes
+){
+    int first = arcs.start[old_label->current_];
+    int last = arcs.start[old_label->current_ + 1];
+    int remaining_cap = modelData->max_caps[day] - old_label->cap_;
+    double time = old_label->time_;
+    const double* travel = arcs.travel.data();
+    const double* preService = arcs.preService.data();
+    const double* postService = arcs.postService.data();
+    const double* earliest = arcs.earliest.data();
+    const double* latest = arcs.latest.data();
+    const int* demand = arcs.demand.data();
+    double* times = newTimes.data();
+
+    assert((int) newTimes.size() >= last - first);
+
+    /* no branches and only packed data, such that the loop can be vectorised */
+    for(int a = first; a < last; a++)
+    {
+        double arrival = time + travel[a] + preService[a];
+        double departure = std::max(earliest[a], arrival) + postService[a];
+        bool feasible = demand[a] <= remaining_cap && arrival <= latest[a];
+        times[a - first] = feasible ? departure : SCIP_INVALID;
+    }
+}
+
+template<bool isFW, bool withSRC, bool withEC>
+Label2* label_create2(
         ObjPricerVRP*   pricerData,
         Label2*         old_label,
-        SCIP_Bool       isFW,
-        int             end,
-        int             day
+        arc_table&      arcs,
+        int             arc,
+        double          new_time,
+        int             day,
+        bool            shrinkNG
 ){
-    int capacity, start;
-    double arrival, new_time;
+    int end;
     SCIP_Real red_costs;
     double obj;
     double state;
     Label2* new_label;
     bitset<neighborhood_size> ng_memory;
-    bool isEnforced = pricerData->eC_[end] == day;
+    day_graph& graph = pricerData->dayGraphs_[day];
 
     assert(old_label != nullptr);
-    assert(0 <= end && end <= modelData->nC);
+    end = arcs.head[arc];
+    assert(0 <= end && end < graph.n);
     assert(old_label->current_ != end);
-    start = old_label->current_;
-
-    /* customer would exceed max capacity */
-    capacity = old_label->cap_ + modelData->demand[end];
-    if(modelData->max_caps[day] < capacity)
-        return nullptr;
-    /* update time rescource */
-    arrival = old_label->time_ + modelData->travel[start][end];
-    if(isFW) /* forward label */
-    {
-        if(modelData->timeWindows[end][day].end < arrival)
-            return nullptr;
-        /* start of service */
-        new_time = std::max(double(modelData->timeWindows[end][day].start), arrival);
-        /* if start of service exceeds the Half way point: return null */
-//        if(new_time > (double) modelData->timeWindows[0][day].end / 2)
-//            return nullptr;
-        /* departure time */
-        new_time += modelData->service[end];
-    }else /* backwards label */
-    {
-        arrival += modelData->service[end];
-        if(modelData->timeWindows[0][day].end - modelData->timeWindows[end][day].start < arrival)
-            return nullptr;
-        /* calculate new time (consider possible waiting time) */
-        new_time = std::max(double(modelData->timeWindows[0][day].end - modelData->timeWindows[end][day].end), arrival);
-        // TODO: check if enough
-//        if(new_time > (double) modelData->timeWindows[0][day].end / 2)
-//            return nullptr;
-    }
-    /* set new ng-memory */
-    if(USE_DSSR)
-        ng_memory = old_label->ng_memory_ & pricerData->ng_DSSR_[end];
+    assert(new_time != SCIP_INVALID);
+    assert(arcs.isFW == isFW);
+    assert(withSRC || pricerData->nnonzSRC_ == 0);
+    assert(withEC || pricerData->nEC_[day] == 0);
+
+    bool isEnforced = withEC && graph.isEnforced[end];
+
+    /* set new ng-memory, shrunk to the customer itself if the label budget of the thread is exceeded */
+    if(shrinkNG)
+        ng_memory.reset();
     else
-        ng_memory = old_label->ng_memory_ & modelData->ng_set[end];
+        ng_memory = old_label->ng_memory_ & graph.ngSet[end];
     ng_memory[end] = true;
 
-    /* calculate new reduced costs */
-    if(isFW)
-    {
-        red_costs = old_label->red_costs_ + pricerData->arcPrices_[start][end];
-    }else
-    {
-        red_costs = old_label->red_costs_ + pricerData->arcPrices_[end][start];
-    }
-    if(isEnforced)
-        red_costs -= ENFORCED_PRICE_COLLECTING;
-
-//    red_costs = old_label->red_costs_ - pricerData->dualValues_[end];
-//    if(!isFarkas && modelData->minTravel)
-//        red_costs += modelData->travel[start][end];
+    /* calculate new reduced costs (the prize of enforced customers is part of the arc prices) */
+    red_costs = old_label->red_costs_ + arcs.price[arc];
 
-    obj = old_label->obj_ + modelData->travel[start][end];
+    obj = old_label->obj_ + arcs.travel[arc];
 
-    new_label = new Label2(red_costs, end, capacity, pricerData->nnonzSRC_, new_time, obj, ng_memory, old_label->visitedEC_);
+    new_label = new Label2(red_costs, end, old_label->cap_ + arcs.demand[arc], pricerData->nnonzSRC_,
+                           pricerData->nAltDuals_, new_time, obj, ng_memory, old_label->visitedEC_);
     if(isEnforced)
         new_label->visitedEC_[end] = true;
 
+    /* check if the label still follows the forbidden route */
+    if(old_label->forbiddenPrefix_ >= 0)
+    {
+        int length = (int) graph.forbiddenTour.size();
+        int pos = old_label->forbiddenPrefix_;
+        if(pos < length && end == graph.forbiddenTour[isFW ? pos : length - 1 - pos])
+            new_label->forbiddenPrefix_ = pos + 1;
+    }
+
+    /* calculate new reduced costs for additional dual vectors */
+    for(int k = 0; k < pricerData->nAltDuals_; k++)
+    {
+        new_label->altRedCosts_[k] = old_label->altRedCosts_[k] + arcs.altPrice[k][arc];
+    }
+
     /* update subset row cuts states */
-//    if(pricerData->nnonzSRC_ == 18 && day == 0 && start == 0 && end == 30)
-//        cout << "start it: " << endl;
-    for(int c = 0; c < pricerData->nnonzSRC_; c++)
+    for(int c = 0; withSRC && c < pricerData->nnonzSRC_; c++)
     {
         assert(SCIPisNegative(pricerData->scip_, pricerData->SRC_dualv[c]));
         assert(pricerData->SRC_para_[c] == 0.5);
         state = old_label->SRCstate_[c];
 
-        if((*pricerData->SRC_Set_[c])[end])
+        if(graph.inSRC[c * graph.n + end])
             state += pricerData->SRC_para_[c];
         if(SCIPisGE(pricerData->scip_, state, 1))
         {
             new_label->red_costs_ -= pricerData->SRC_dualv[c];
+            for(auto& rc : new_label->altRedCosts_)
+                rc -= pricerData->SRC_dualv[c];
             state -= 1;
         }
         new_label->SRCstate_[c] = state;
@@ -105,3 +118,13 @@ Label2* label_propagate2(
 
     return new_label;
 }
+
+/* labeling kernels for each direction and resource configuration */
+template Label2* label_create2<true, false, false>(ObjPricerVRP*, Label2*, arc_table&, int, double, int, bool);
+template Label2* label_create2<true, false, true>(ObjPricerVRP*, Label2*, arc_table&, int, double, int, bool);
+template Label2* label_create2<true, true, false>(ObjPricerVRP*, Label2*, arc_table&, int, double, int, bool);
+template Label2* label_create2<true, true, true>(ObjPricerVRP*, Label2*, arc_table&, int, double, int, bool);
+template Label2* label_create2<false, false, false>(ObjPricerVRP*, Label2*, arc_table&, int, double, int, bool);
+template Label2* label_create2<false, false, true>(ObjPricerVRP*, Label2*, arc_table&, int, double, int, bool);
+template Label2* label_create2<false, true, false>(ObjPricerVRP*, Label2*, arc_table&, int, double, int, bool);
+template Label2* label_create2<false, true, true>(ObjPricerVRP*, Label2*, arc_table&, int, double, int, bool);
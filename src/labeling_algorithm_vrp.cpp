@@ -15,14 +15,19 @@
 #include "tools_vrp.h"
 #include "tourVRP.h"
 #include "label2.h"
+#include "var_tools.h"
+#include "heurRestrictedMaster.h"
 
 
 static
 SCIP_RETCODE getToursFromLabelPairs(
         SCIP*               scip,
         model_data*         modelData,
+        day_graph&          graph,
         vector<pair<pair<LabelNode*, LabelNode*>, double>> &sol_pairs,
         vector<tourVRP>     &finalTours,
+        vector<double>      &redCosts,
+        int                 maxTours,
         int                 day
 ){
     double last = 0.0;
@@ -31,7 +36,7 @@ SCIP_RETCODE getToursFromLabelPairs(
 
     for(auto sol : sol_pairs)
     {
-        if(count > 20)
+        if(count >= maxTours)
             break;
         if(SCIPisEQ(scip, sol.second, last))
             continue;
@@ -40,7 +45,7 @@ SCIP_RETCODE getToursFromLabelPairs(
         node = sol.first.first;
         while(node->label2_->current_ != 0)
         {
-            cap += modelData->demand[node->label2_->current_];
+            cap += modelData->demand[graph.toGlobal[node->label2_->current_]];
             fw_length++;
             node = node->parent_;
         }
@@ -50,22 +55,25 @@ SCIP_RETCODE getToursFromLabelPairs(
         node = sol.first.first;
         while (node->label2_->current_ != 0)
         {
-            finalTours[count].tour_[--fw_length] = node->label2_->current_;
+            finalTours[count].tour_[--fw_length] = graph.toGlobal[node->label2_->current_];
             node = node->parent_;
         }
         /* tour from bw_label */
         node = sol.first.second;
         while(node->label2_->current_ != 0)
         {
-            finalTours[count].tour_.push_back(node->label2_->current_);
+            finalTours[count].tour_.push_back(graph.toGlobal[node->label2_->current_]);
             finalTours[count].length_++;
-            cap += modelData->demand[node->label2_->current_];
+            cap += modelData->demand[graph.toGlobal[node->label2_->current_]];
             node = node->parent_;
         }
+        /* labels use local indices of the day */
         finalTours[count].obj_ = sol.first.first->label2_->obj_ + sol.first.second->label2_->obj_ +
-                                 modelData->travel[sol.first.first->label2_->current_][sol.first.second->label2_->current_];
+                                 graph.travel[sol.first.first->label2_->current_ * graph.n +
+                                              sol.first.second->label2_->current_];
         finalTours[count].capacity_ = cap;
         assert(finalTours[count].checkObj(modelData));
+        redCosts.push_back(sol.second);
         count++;
         last = sol.second;
     }
@@ -74,71 +82,342 @@ SCIP_RETCODE getToursFromLabelPairs(
 }
 
 
+/** computes for each customer the minimal time from the end of its service until the depot is reached (forward) or
+ *  from leaving the depot until the start of its service (backward) in the current neighborhood of a day
+ *  (Dijkstra, time windows are relaxed) */
+static
+void setMinReturnTimes(
+        model_data*         modelData,
+        ObjPricerVRP*       pricerData,
+        int                 day,
+        bool                isFW,
+        vector<double>      &minReturn
+){
+    priority_queue<pair<double, int>, vector<pair<double, int>>, greater<pair<double, int>>> heap;
+    vector<bool> isDone(modelData->nC, false);
+
+    minReturn.assign(modelData->nC, SCIP_DEFAULT_INFINITY);
+    for(int v = 1; v < modelData->nC; v++)
+    {
+        minReturn[v] = isFW ? modelData->travel[v][0] : modelData->travel[0][v];
+        heap.emplace(minReturn[v], v);
+    }
+    while(!heap.empty())
+    {
+        int w = heap.top().second;
+        heap.pop();
+        if(isDone[w])
+            continue;
+        isDone[w] = true;
+        /* customers that can be visited directly before (forward) or after (backward) w */
+        for(auto u : isFW ? pricerData->predecessors_[w][day] : pricerData->neighbors_[w][day])
+        {
+            if(u == 0)
+                continue;
+            double dist = minReturn[w] + modelData->service[w]
+                    + (isFW ? modelData->travel[u][w] : modelData->travel[w][u]);
+            if(dist < minReturn[u])
+            {
+                minReturn[u] = dist;
+                heap.emplace(dist, u);
+            }
+        }
+    }
+}
+
+/** builds the compact subgraph of a day with the current timetable, arc prices and cuts */
+static
+void setDayGraph(
+        model_data*         modelData,
+        ObjPricerVRP*       pricerData,
+        int                 day,
+        bool                excludeTour
+){
+    day_graph& graph = pricerData->dayGraphs_[day];
+    bit_matrix& timetable = pricerData->atRoot_ ? pricerData->global_timetable_ : pricerData->timetable_;
+    vector<bitset<neighborhood_size>>& ngSets = USE_DSSR ? pricerData->ng_DSSR_ : modelData->ng_set;
+
+    /* relabel the depot and the customers of the day */
+    graph.toGlobal.assign(1, 0);
+    graph.toLocal.assign(modelData->nC, -1);
+    graph.toLocal[0] = 0;
+    for(int u = 1; u < modelData->nC; u++)
+    {
+        if(timetable[u][day] && pricerData->global_timetable_[u][day])
+        {
+            graph.toLocal[u] = (int) graph.toGlobal.size();
+            graph.toGlobal.push_back(u);
+        }
+    }
+    int n = graph.n = (int) graph.toGlobal.size();
+    assert(n <= (int) neighborhood_size);
+
+    graph.ngSet.assign(n, bitset<neighborhood_size>());
+    graph.isEnforced.assign(n, 0);
+    graph.inSRC.assign((size_t) pricerData->nnonzSRC_ * n, 0);
+    graph.travel.resize((size_t) n * n);
+    for(int i = 0; i < n; i++)
+    {
+        int gi = graph.toGlobal[i];
+        for(int j = 0; j < n; j++)
+        {
+            int gj = graph.toGlobal[j];
+            if(ngSets[gi][gj])
+                graph.ngSet[i][j] = true;
+            graph.travel[i * n + j] = modelData->travel[gi][gj];
+        }
+        if(pricerData->nEC_[day] > 0 && pricerData->eC_[gi] == day)
+            graph.isEnforced[i] = 1;
+        for(int c = 0; c < pricerData->nnonzSRC_; c++)
+            graph.inSRC[c * n + i] = (*pricerData->SRC_Set_[c])[gi];
+    }
+
+    /* only the arcs of the current neighborhood are allowed, their prices are precomputed per arc by the pricer;
+     * label values are the minimal reduced costs over all dual vectors */
+    bool withAlt = pricerData->nAltDuals_ > 0;
+    graph.isForbidden.assign((size_t) n * n, 1);
+    graph.price.assign((size_t) n * n, SCIP_DEFAULT_INFINITY);
+    graph.boundPrice.assign((size_t) n * n, SCIP_DEFAULT_INFINITY);
+    graph.altPrice.resize(pricerData->nAltDuals_);
+    for(auto& prices : graph.altPrice)
+        prices.assign((size_t) n * n, SCIP_DEFAULT_INFINITY);
+    for(int i = 0; i < n; i++)
+    {
+        int gi = graph.toGlobal[i];
+        day_adjacency::list_ref heads = pricerData->neighbors_[gi][day];
+        int offset = pricerData->neighbors_.offset(gi, day);
+        for(int a = 0; a < heads.size(); a++)
+        {
+            int j = graph.toLocal[heads[a]];
+            if(j < 0)
+                continue;
+            graph.isForbidden[i * n + j] = 0;
+            graph.price[i * n + j] = pricerData->arcPrices_[offset + a];
+            graph.boundPrice[i * n + j] = withAlt ? pricerData->minArcPrices_[offset + a] : graph.price[i * n + j];
+            for(int k = 0; k < pricerData->nAltDuals_; k++)
+                graph.altPrice[k][i * n + j] = pricerData->altArcPrices_[k][offset + a];
+        }
+    }
+    /* arcs back to the depot have the same price for all dual vectors */
+    for(int gi : pricerData->predecessors_[0][day])
+    {
+        int i = graph.toLocal[gi];
+        if(i < 0)
+            continue;
+        graph.isForbidden[i * n] = 0;
+        graph.price[i * n] = graph.boundPrice[i * n] = pricerData->returnPrices_[gi];
+        for(int k = 0; k < pricerData->nAltDuals_; k++)
+            graph.altPrice[k][i * n] = pricerData->returnPrices_[gi];
+    }
+
+    graph.forbiddenTour.clear();
+    if(excludeTour)
+    {
+        for(auto u : pricerData->getExcludedTour(pricerData->scip_)->tour_)
+            graph.forbiddenTour.push_back(graph.toLocal[u]);
+    }
+}
+
+/** packs the arc data of the current neighborhood of a day for both labeling directions in local indices,
+ *  arcs to customers from which the depot cannot be reached in time are dropped */
+static
+void setArcTables(
+        model_data*         modelData,
+        ObjPricerVRP*       pricerData,
+        int                 day
+){
+    arc_table& fw = pricerData->fwArcs_[day];
+    arc_table& bw = pricerData->bwArcs_[day];
+    day_graph& graph = pricerData->dayGraphs_[day];
+    int n = graph.n;
+    double T = modelData->timeWindows[0][day].end;
+    vector<double> fwReturn;
+    vector<double> bwReturn;
+
+    setMinReturnTimes(modelData, pricerData, day, true, fwReturn);
+    setMinReturnTimes(modelData, pricerData, day, false, bwReturn);
+
+    for(auto* arcs : {&fw, &bw})
+    {
+        arcs->start.assign(n + 1, 0);
+        arcs->head.clear();
+        arcs->travel.clear();
+        arcs->preService.clear();
+        arcs->postService.clear();
+        arcs->earliest.clear();
+        arcs->latest.clear();
+        arcs->demand.clear();
+        arcs->price.clear();
+        arcs->altPrice.assign(pricerData->nAltDuals_, vector<SCIP_Real>());
+    }
+    fw.isFW = true;
+    bw.isFW = false;
+
+    for(int lu = 0; lu < n; lu++)
+    {
+        int u = graph.toGlobal[lu];
+        fw.start[lu] = (int) fw.head.size();
+        for(auto v : pricerData->neighbors_[u][day])
+        {
+            int lv = graph.toLocal[v];
+            if(lv < 0)
+                continue;
+            /* latest departure from v such that the depot is still reached in time */
+            double latestDeparture = T - fwReturn[v];
+            if(modelData->timeWindows[v][day].start + modelData->service[v] > latestDeparture)
+                continue;
+            fw.head.push_back(lv);
+            fw.travel.push_back(modelData->travel[u][v]);
+            fw.preService.push_back(0.0);
+            fw.postService.push_back(modelData->service[v]);
+            fw.earliest.push_back(modelData->timeWindows[v][day].start);
+            fw.latest.push_back(min((double) modelData->timeWindows[v][day].end,
+                                    latestDeparture - modelData->service[v]));
+            fw.demand.push_back(modelData->demand[v]);
+            fw.price.push_back(graph.price[lu * n + lv]);
+            for(int k = 0; k < pricerData->nAltDuals_; k++)
+                fw.altPrice[k].push_back(graph.altPrice[k][lu * n + lv]);
+        }
+        bw.start[lu] = (int) bw.head.size();
+        for(auto v : pricerData->predecessors_[u][day])
+        {
+            int lv = graph.toLocal[v];
+            if(lv < 0)
+                continue;
+            /* same in mirrored time: the depot has to be reachable backwards from v */
+            double latestDeparture = T - bwReturn[v];
+            if(T - modelData->timeWindows[v][day].end > latestDeparture)
+                continue;
+            bw.head.push_back(lv);
+            bw.travel.push_back(modelData->travel[u][v]);
+            bw.preService.push_back(modelData->service[v]);
+            bw.postService.push_back(0.0);
+            bw.earliest.push_back(T - modelData->timeWindows[v][day].end);
+            bw.latest.push_back(min(T - modelData->timeWindows[v][day].start, latestDeparture));
+            bw.demand.push_back(modelData->demand[v]);
+            bw.price.push_back(graph.price[lv * n + lu]);
+            for(int k = 0; k < pricerData->nAltDuals_; k++)
+                bw.altPrice[k].push_back(graph.altPrice[k][lv * n + lu]);
+        }
+    }
+    fw.start[n] = (int) fw.head.size();
+    bw.start[n] = (int) bw.head.size();
+}
+
+/** bidirectional labeling loop, specialised on the active resources */
+template<bool withSRC, bool withEC>
+static
+void runBiDirLabeling(
+        SCIP*               scip,
+        model_data*         modelData,
+        ObjPricerVRP*       pricerData,
+        int                 day,
+        vector<LabelList*>  &labelLists_fw,
+        vector<LabelList*>  &propLabelLists_fw,
+        vector<LabelList*>  &labelLists_bw,
+        vector<LabelList*>  &propLabelLists_bw,
+        queue<int>          &indexQ,
+        vector<bool>        &isInQ,
+        vector<double>      &newTimes,
+        bool                getDayVarRed,
+        label_budget        &budget
+){
+    while(!indexQ.empty())
+    {
+        assert(labelLists_fw[indexQ.front()] != nullptr || labelLists_bw[indexQ.front()] != nullptr);
+        /* propagate all forwards labels of customer */
+        if(labelLists_fw[indexQ.front()]->length_ > 0)
+            propagateCustomer<true, withSRC, withEC>(scip, modelData, pricerData, day, propLabelLists_fw, indexQ,
+                                                     labelLists_fw, isInQ, newTimes, getDayVarRed, budget);
+        /* propagate all backwards labels of customer */
+        if(labelLists_bw[indexQ.front()]->length_ > 0)
+            propagateCustomer<false, withSRC, withEC>(scip, modelData, pricerData, day, propLabelLists_bw, indexQ,
+                                                      labelLists_bw, isInQ, newTimes, getDayVarRed, budget);
+        /* the remaining labels are discarded, the tours found so far get returned */
+        if(budget.stage == 2)
+            break;
+        isInQ[indexQ.front()] = FALSE;
+        indexQ.pop();
+    }
+}
+
 SCIP_RETCODE generateLabelsBiDir(
         SCIP*               scip,
         model_data*         modelData,
         ObjPricerVRP*       pricerData,
         vector<tourVRP>&    bestTours,
-        bool                isFarkas,
+        vector<double>&     bestRedCosts,
         bool                getDayVarRed,
         bool                isHeuristic,
-        bool                noDominance,
+        bool                excludeTour,
         int                 day
 ){
-    vector<LabelList*> labelLists_fw(modelData->nC);        /* vector of lists of non-propagated fw-labels */
-    vector<LabelList*> propLabelLists_fw(modelData->nC);    /* vector of lists of propagated fw-labels */
-    vector<LabelList*> labelLists_bw(modelData->nC);        /* vector of lists of non-propagated bw-labels */
-    vector<LabelList*> propLabelLists_bw(modelData->nC);    /* vector of lists of propagated bw-labels */
+    /* build the compact subgraph of the day and pack its arc data */
+    setDayGraph(modelData, pricerData, day, excludeTour);
+    setArcTables(modelData, pricerData, day);
+    int n = pricerData->dayGraphs_[day].n;
+    vector<LabelList*> labelLists_fw(n);        /* vector of lists of non-propagated fw-labels */
+    vector<LabelList*> propLabelLists_fw(n);    /* vector of lists of propagated fw-labels */
+    vector<LabelList*> labelLists_bw(n);        /* vector of lists of non-propagated bw-labels */
+    vector<LabelList*> propLabelLists_bw(n);    /* vector of lists of propagated bw-labels */
     int i;
-    double start_redcosts;
     queue<int> indexQ;
     Label2* new_label2;
     LabelNode* new_node;
 
-    /* check which step of optimization */
-    start_redcosts = -pricerData->dualValues_[modelData->nC + day] + pricerData->nEC_[day] * ENFORCED_PRICE_COLLECTING;
-    start_redcosts -= pricerData->dual_nVehicle_;
-    if(!modelData->minTravel && !isFarkas)
-    {
-        start_redcosts += 1;
-    }
-    for(i = 0; i < modelData->nC; i++)
+    for(i = 0; i < n; i++)
     {
         labelLists_fw[i] = new LabelList();
         propLabelLists_fw[i] = new LabelList();
         labelLists_bw[i] = new LabelList();
         propLabelLists_bw[i] = new LabelList();
     }
-    vector<bool> isInQ(modelData->nC, FALSE);
+    vector<double> newTimes(n);
+
+    vector<bool> isInQ(n, FALSE);
     bitset<neighborhood_size> emtpy_bitset;
     indexQ.push(0);
-    /* initial forwards label */
-    new_label2 = new Label2(start_redcosts, 0, 0, pricerData->nnonzSRC_, 0.0, 0.0, emtpy_bitset, emtpy_bitset);
-    new_node = new LabelNode(new_label2, start_redcosts);
+    /* initial forwards label, the constant duals of the route are part of the prices of the arcs leaving the depot */
+    new_label2 = new Label2(0.0, 0, 0, pricerData->nnonzSRC_, pricerData->nAltDuals_, 0.0, 0.0,
+                            emtpy_bitset, emtpy_bitset);
+    /* the initial labels are prefixes of the route that must not be generated */
+    if(excludeTour)
+        new_label2->forbiddenPrefix_ = 0;
+    new_node = new LabelNode(new_label2, new_label2->getMinRedCosts());
     labelLists_fw[0]->insert_node(new_node);
     /* initial backwards label */
-    new_label2 = new Label2(0.0, 0, 0, pricerData->nnonzSRC_, 0.0, 0.0, emtpy_bitset, emtpy_bitset);
+    new_label2 = new Label2(0.0, 0, 0, pricerData->nnonzSRC_, pricerData->nAltDuals_, 0.0, 0.0,
+                            emtpy_bitset, emtpy_bitset);
+    if(excludeTour)
+        new_label2->forbiddenPrefix_ = 0;
     new_node = new LabelNode(new_label2, 0);
     labelLists_bw[0]->insert_node(new_node);
 
-    if(isHeuristic)
-        cout << "heuristic" << endl;
+    /* heuristic labeling stops at twice its budget, exact labeling only shrinks the ng-sets */
+    label_budget budget = {isHeuristic ? pricerData->heurMaxLabels_ : pricerData->maxLabels_, LabelNode::nAlive_,
+                           isHeuristic, 0};
     /* bidirectional labeling algorithm */
-//    if(noDominance)
-//        cout << "Without Dominance check" << endl;
-    while(!indexQ.empty())
+    /* pick the labeling kernel for the active resources once per day */
+    if(pricerData->nnonzSRC_ > 0)
     {
-        assert(labelLists_fw[indexQ.front()] != nullptr || labelLists_bw[indexQ.front()] != nullptr);
-        /* propagate all forwards labels of customer */
-        if(labelLists_fw[indexQ.front()]->length_ > 0)
-            propagateCustomer(scip, modelData, pricerData, day, propLabelLists_fw, indexQ, labelLists_fw,
-                              isInQ, TRUE, getDayVarRed, noDominance);
-        /* propagate all backwards labels of customer */
-        if(labelLists_bw[indexQ.front()]->length_ > 0)
-            propagateCustomer(scip, modelData, pricerData, day, propLabelLists_bw, indexQ, labelLists_bw,
-                              isInQ, FALSE, getDayVarRed, noDominance);
-        isInQ[indexQ.front()] = FALSE;
-        indexQ.pop();
+        if(pricerData->nEC_[day] > 0)
+            runBiDirLabeling<true, true>(scip, modelData, pricerData, day, labelLists_fw, propLabelLists_fw,
+                                         labelLists_bw, propLabelLists_bw, indexQ, isInQ, newTimes, getDayVarRed,
+                                         budget);
+        else
+            runBiDirLabeling<true, false>(scip, modelData, pricerData, day, labelLists_fw, propLabelLists_fw,
+                                          labelLists_bw, propLabelLists_bw, indexQ, isInQ, newTimes, getDayVarRed,
+                                         budget);
+    }else
+    {
+        if(pricerData->nEC_[day] > 0)
+            runBiDirLabeling<false, true>(scip, modelData, pricerData, day, labelLists_fw, propLabelLists_fw,
+                                          labelLists_bw, propLabelLists_bw, indexQ, isInQ, newTimes, getDayVarRed,
+                                         budget);
+        else
+            runBiDirLabeling<false, false>(scip, modelData, pricerData, day, labelLists_fw, propLabelLists_fw,
+                                           labelLists_bw, propLabelLists_bw, indexQ, isInQ, newTimes, getDayVarRed,
+                                         budget);
     }
 //    for(i = 0; i < modelData->nC; i++)
 //    {
@@ -146,14 +425,27 @@ SCIP_RETCODE generateLabelsBiDir(
 //        assert(labelLists_bw[i]->length_ == 0);
 //    }
 
+    /* remove the remaining labels of dominated subtrees */
+    for(i = 0; i < n; i++)
+    {
+        propLabelLists_fw[i]->compact();
+        propLabelLists_bw[i]->compact();
+    }
+
     /* concatenate fw and bw labels */
     vector<pair<pair<LabelNode*, LabelNode*>, double>> sol_pairs;
     SCIP_CALL(concatenateLabels(scip, modelData, pricerData, getDayVarRed, day,
                                 propLabelLists_fw, propLabelLists_bw, sol_pairs));
 
-    getToursFromLabelPairs(scip, modelData, sol_pairs, bestTours, day);
+    getToursFromLabelPairs(scip, modelData, pricerData->dayGraphs_[day], sol_pairs, bestTours, bestRedCosts,
+                           pricerData->maxCandsPerDay_, day);
 
-    for(i = 0; i < modelData->nC; i++)
+    /* degraded heuristic labeling might miss tours, the minimum reduced costs of the day are unknown */
+    pricerData->labelStage_[day] = budget.stage;
+    if(isHeuristic && budget.stage > 0)
+        pricerData->dayMinRedCosts_[day] = -SCIP_DEFAULT_INFINITY;
+
+    for(i = 0; i < n; i++)
     {
         delete labelLists_fw[i];
         delete labelLists_bw[i];
@@ -164,6 +456,7 @@ SCIP_RETCODE generateLabelsBiDir(
     return SCIP_OKAY;
 }
 
+template<bool isFW, bool withSRC, bool withEC>
 SCIP_RETCODE propagateCustomer(
         SCIP*               scip,
         model_data          *modelData,
@@ -173,9 +466,9 @@ SCIP_RETCODE propagateCustomer(
         queue<int>          &indexQ,
         vector<LabelList*>  &labelLists,
         vector<bool>        &isInQ,
-        bool                isFW,
+        vector<double>      &newTimes,
         bool                getDayVarRed,
-        bool                noDominance
+        label_budget        &budget
 ){
     LabelNode* curr_node;
     LabelNode* last_node;
@@ -185,42 +478,64 @@ SCIP_RETCODE propagateCustomer(
     Label2* curr_label2;
     int dom_active;
     int dom_old;
-    vector<int> &neighbors = isFW ? pricerData->neighbors_[current_index][day] : pricerData->predecessors_[current_index][day];
-    vector<vector<bool>>& timetable = pricerData->atRoot_ ? pricerData->global_timetable_ : pricerData->timetable_;
-    while(labelLists[current_index]->length_ > 0)
+    arc_table& arcs = isFW ? pricerData->fwArcs_[day] : pricerData->bwArcs_[day];
+    int first_arc = arcs.start[current_index];
+    int last_arc = arcs.start[current_index + 1];
+    while(labelLists[current_index]->length_ > 0 && budget.stage < 2)
     {
         curr_node = labelLists[current_index]->extract_first();
+        /* an ancestor got dominated */
+        if(curr_node->is_dead_)
+        {
+            curr_node->delete_from_family_tree();
+            delete curr_node;
+            continue;
+        }
         curr_label2 = curr_node->label2_;
 
         if(getDayVarRed || curr_label2->time_ <= (double) modelData->timeWindows[0][day].end / 2) // TODO: can we make it sharp? - Prob. no!
         {
             last_node = nullptr;
-            for(auto neighbor : neighbors)
+            /* check capacity and time windows for all neighbors at once */
+            label_extend_all(modelData, curr_label2, arcs, day, newTimes);
+            for(int a = first_arc; a < last_arc; a++)
             {
-                assert(timetable[neighbor][day]);
+                /* an ancestor got dominated by one of the new labels */
+                if(curr_node->is_dead_)
+                    break;
+                int neighbor = arcs.head[a];
 
+                /* skip neighbor if capacity or time windows get violated */
+                if(newTimes[a - first_arc] == SCIP_INVALID)
+                    continue;
                 /* skip neighbor if ng-condition gets violated */
                 if(curr_label2->ng_memory_[neighbor])
                     continue;
-                if(curr_label2->visitedEC_[neighbor])
+                if(withEC && curr_label2->visitedEC_[neighbor])
                 {
-                    assert(pricerData->eC_[neighbor] == day);
+                    assert(pricerData->dayGraphs_[day].isEnforced[neighbor]);
                     continue;
                 }
 
-                new_label2 = label_propagate2(modelData, pricerData, curr_label2, isFW, neighbor, day);
+                /* exact labeling: ng-sets get shrunk after the budget is exceeded, this keeps the pricing a
+                 * relaxation (the bound stays valid), but the new columns might be non-elementary */
+                new_label2 = label_create2<isFW, withSRC, withEC>(pricerData, curr_label2, arcs, a,
+                                                                  newTimes[a - first_arc], day,
+                                                                  budget.stage > 0 && !budget.isHeuristic);
 
-                if(new_label2 == nullptr)
-                    continue;
-
-                if(noDominance)
+                /* heuristic labeling: subset row cuts are ignored in the dominance after the budget is exceeded */
+                if(budget.stage > 0 && budget.isHeuristic)
                 {
-                    dom_active = 0;
-                    dom_old = 0;
+                    dom_active = dominance_check2<false, withEC>(labelLists, propLabelLists, new_label2, FALSE,
+                                                                 pricerData, scip);
+                    dom_old = dominance_check2<false, withEC>(labelLists, propLabelLists, new_label2, TRUE,
+                                                              pricerData, scip);
                 }else
                 {
-                    dom_active = dominance_check2(labelLists, propLabelLists, new_label2, FALSE, pricerData, scip);
-                    dom_old = dominance_check2(labelLists, propLabelLists, new_label2, TRUE, pricerData, scip);
+                    dom_active = dominance_check2<withSRC, withEC>(labelLists, propLabelLists, new_label2, FALSE,
+                                                                   pricerData, scip);
+                    dom_old = dominance_check2<withSRC, withEC>(labelLists, propLabelLists, new_label2, TRUE,
+                                                                pricerData, scip);
                 }
 
                 if(dom_old > 0)
@@ -237,7 +552,7 @@ SCIP_RETCODE propagateCustomer(
                 }else
                 {
                     assert(dom_active >= 0);
-                    new_node = new LabelNode(new_label2, new_label2->red_costs_);
+                    new_node = new LabelNode(new_label2, new_label2->getMinRedCosts());
                     labelLists[neighbor]->insert_node(new_node);
 
                     /* add current customer to index Q */
@@ -258,6 +573,19 @@ SCIP_RETCODE propagateCustomer(
                     }
                     new_node->parent_ = curr_node;
                     last_node = new_node;
+                    /* the dominance check of the new label killed an ancestor, the label is removed lazily */
+                    if(curr_node->is_dead_)
+                        new_node->is_dead_ = TRUE;
+
+                    /* check the label budget of the thread, dominated and dead labels that got freed do not count */
+                    if(budget.maxLabels >= 0 &&
+                       LabelNode::nAlive_ - budget.startLabels >= (budget.stage + 1) * budget.maxLabels)
+                    {
+                        if(budget.stage == 0)
+                            budget.stage = 1;
+                        else if(budget.isHeuristic)
+                            budget.stage = 2;
+                    }
                 }
             }
         }
@@ -273,6 +601,7 @@ SCIP_RETCODE propagateCustomer(
 static
 bool isFeasible(
         model_data*         modelData,
+        ObjPricerVRP*       pricerData,
         int                 day,
         Label2*             fw_label,
         Label2*             bw_label
@@ -281,7 +610,8 @@ bool isFeasible(
     if(fw_label->cap_ + bw_label->cap_ > modelData->max_caps[day])
         return FALSE;
     /* check for time rescource */
-    if(fw_label->time_ + bw_label->time_ + modelData->travel[fw_label->current_][bw_label->current_]
+    day_graph& graph = pricerData->dayGraphs_[day];
+    if(fw_label->time_ + bw_label->time_ + graph.travel[fw_label->current_ * graph.n + bw_label->current_]
         > modelData->timeWindows[0][day].end)
         return FALSE;
     /* check for ng-path rescources */
@@ -291,6 +621,11 @@ bool isFeasible(
     if((fw_label->visitedEC_ & bw_label->visitedEC_) != 0)
         return FALSE;
 
+    /* check if the labels form the route that must not be generated */
+    if(fw_label->forbiddenPrefix_ >= 0 && bw_label->forbiddenPrefix_ >= 0 &&
+       fw_label->forbiddenPrefix_ + bw_label->forbiddenPrefix_ == (int) graph.forbiddenTour.size())
+        return FALSE;
+
     /* TODO: check for non-robust-cuts rescources (when implemented) */
 
     return TRUE;
@@ -309,15 +644,19 @@ SCIP_RETCODE concatenateLabels(
     //TODO: HOT CODE
     LabelNode* fw_node;
     LabelNode* bw_node;
-    vector<vector<bool>>& timetable = pricerData->atRoot_ ? pricerData->global_timetable_ : pricerData->timetable_;
-    vector<vector<bool>>& isForbidden = pricerData->atRoot_ ? pricerData->global_isForbidden_ : pricerData->isForbidden_;
+    day_graph& graph = pricerData->dayGraphs_[day];
+    int n = graph.n;
     double best_bw = SCIP_DEFAULT_INFINITY;
     double best_fw = SCIP_DEFAULT_INFINITY;
-    vector<double> best_fw_cust(modelData->nC, SCIP_DEFAULT_INFINITY);
-    vector<double> best_bw_cust(modelData->nC, SCIP_DEFAULT_INFINITY);
+    vector<double> best_fw_cust(n, SCIP_DEFAULT_INFINITY);
+    vector<double> best_bw_cust(n, SCIP_DEFAULT_INFINITY);
     double minred = 0.0;
-    modelData->neighbors[0][day].push_back(0);
-    for(auto i : modelData->neighbors[0][day])
+    /* local customers of the day and the depot */
+    vector<int> customers;
+    for(int i = 1; i < n; i++)
+        customers.push_back(i);
+    customers.push_back(0);
+    for(auto i : customers)
     {
         if(fw_list[i]->length_ > 0)
         {
@@ -336,29 +675,25 @@ SCIP_RETCODE concatenateLabels(
     }
 
     int count = 0;
-    for(auto i : modelData->neighbors[0][day])
+    for(auto i : customers)
     {
-        if(!timetable[i][day])
-            continue;
         double minred_i = SCIP_DEFAULT_INFINITY;
 
         fw_node = fw_list[i]->head_;
         while (fw_node != nullptr)
         {
-            for(auto j : modelData->neighbors[0][day])
+            for(auto j : customers)
             {
-                if(!timetable[j][day])
-                    continue;
                 if(i == j)
                     continue;
-                if(isForbidden[i][j])
+                if(graph.isForbidden[i * n + j])
                     continue;
                 double minred_ij = SCIP_DEFAULT_INFINITY;
                 bw_node = bw_list[j]->head_;
                 while(bw_node != nullptr)
                 {
-                    /* reduced costs */
-                    double rc = bw_node->value_ + fw_node->value_ + pricerData->arcPrices_[i][j];
+                    /* lower bound on the reduced costs */
+                    double rc = bw_node->value_ + fw_node->value_ + graph.boundPrice[i * n + j];
 
                     if(!getDayVarRed)
                     {
@@ -370,33 +705,49 @@ SCIP_RETCODE concatenateLabels(
                         if(SCIPisGE(scip, rc, minred_ij) && SCIPisGE(scip, rc, minred_i))
                             break;
                     }
+                    /* reduced costs */
+                    rc = bw_node->label2_->red_costs_ + fw_node->label2_->red_costs_ + graph.price[i * n + j];
                     /* include subset row cut influence */
+                    double src_rc = 0.0;
                     for(int c = 0; c < pricerData->nnonzSRC_; c++)
                     {
                         if(SCIPisGE(scip, fw_node->label2_->SRCstate_[c] + bw_node->label2_->SRCstate_[c], 1))
                         {
-                            rc -= pricerData->SRC_dualv[c];
+                            src_rc -= pricerData->SRC_dualv[c];
                         }
                     }
-                    if(getDayVarRed || SCIPisSumNegative(scip, rc))
+                    rc += src_rc;
+                    /* reduced costs w.r.t. additional dual vectors */
+                    double min_rc = rc;
+                    for(int k = 0; k < pricerData->nAltDuals_; k++)
                     {
-                        if(isFeasible(modelData, day, fw_node->label2_, bw_node->label2_))
+                        double alt_rc = bw_node->label2_->altRedCosts_[k] + fw_node->label2_->altRedCosts_[k] +
+                                        graph.altPrice[k][i * n + j] + src_rc;
+                        if(alt_rc < min_rc)
+                            min_rc = alt_rc;
+                    }
+                    if(getDayVarRed || SCIPisSumNegative(scip, min_rc))
+                    {
+                        if(isFeasible(modelData, pricerData, day, fw_node->label2_, bw_node->label2_))
                         {
-                            /* arc fixing */
-                            if(rc < minred_ij)
-                                minred_ij = rc;
-                            /* assignment fixing */
-                            if(rc < minred_i)
-                                minred_i = rc;
-
-                            if(SCIPisSumNegative(scip, rc))
+                            if(getDayVarRed || SCIPisSumNegative(scip, rc))
+                            {
+                                /* arc fixing */
+                                if(rc < minred_ij)
+                                    minred_ij = rc;
+                                /* assignment fixing */
+                                if(rc < minred_i)
+                                    minred_i = rc;
+                            }
+
+                            if(SCIPisSumNegative(scip, min_rc))
                             {
                                 if(rc < minred)
                                     minred = rc;
 
-                                sol_pairs.emplace_back(pair(fw_node, bw_node), rc);
+                                sol_pairs.emplace_back(pair(fw_node, bw_node), min_rc);
                                 count++;
-                                if(count > 10 && !getDayVarRed)
+                                if(count >= pricerData->maxPairsPerDay_ && !getDayVarRed)
                                     break;
                             }else // getDayVarRed = true - first feasible has the lowest red costs (if there are no cuts)
                             {
@@ -407,27 +758,31 @@ SCIP_RETCODE concatenateLabels(
                     }
                     bw_node = bw_node->next_;
                 }
-                if(minred_ij < pricerData->arcRedCosts_[i][j])
-                    pricerData->arcRedCosts_[i][j] = minred_ij;
-                if(count > 10 && !getDayVarRed)
+                if(minred_ij < pricerData->arcRedCosts_[graph.toGlobal[i]][graph.toGlobal[j]])
+                    pricerData->arcRedCosts_[graph.toGlobal[i]][graph.toGlobal[j]] = minred_ij;
+                if(count >= pricerData->maxPairsPerDay_ && !getDayVarRed)
                     break;
             }
             fw_node = fw_node->next_;
-            if(count > 10 && !getDayVarRed)
+            if(count >= pricerData->maxPairsPerDay_ && !getDayVarRed)
                 break;
         }
         if(getDayVarRed)
         {
-            pricerData->dayVarRedCosts_[i][day] = minred_i;
+            pricerData->dayVarRedCosts_.at(graph.toGlobal[i], day) = minred_i;
         }
-        if(count > 10 && !getDayVarRed)
+        if(count >= pricerData->maxPairsPerDay_ && !getDayVarRed)
             break;
     }
-    modelData->neighbors[0][day].pop_back();
     if(getDayVarRed)
     {
-        pricerData->dayVarRedCosts_[0][day] = minred;
+        pricerData->dayVarRedCosts_.at(0, day) = minred;
     }
+    /* the minimum of the day is only known if all tours with negative reduced costs were enumerated */
+    if(count >= pricerData->maxPairsPerDay_ && !getDayVarRed)
+        pricerData->dayMinRedCosts_[day] = -SCIP_DEFAULT_INFINITY;
+    else
+        pricerData->dayMinRedCosts_[day] = minred;
     sort(sol_pairs.begin(), sol_pairs.end(), [](auto &left, auto &right){
         return left.second < right.second;
     });
@@ -435,14 +790,135 @@ SCIP_RETCODE concatenateLabels(
     return SCIP_OKAY;
 }
 
+SCIP_RETCODE addSelectedTours(
+        SCIP*                       scip,
+        vrp::ProbDataVRP*           probData,
+        ObjPricerVRP*               pricerData,
+        vector<vector<tourVRP>>&    tours,
+        vector<vector<double>>&     redCosts,
+        bool                        isFarkas
+){
+    model_data* modelData = probData->getData();
+    char algoName[] = "pricingLabel";
+    int maxPerDay = pricerData->maxColsPerDay_ >= 0 ? pricerData->maxColsPerDay_ : modelData->nC / 4 + 1;
+    int maxTotal = pricerData->maxCols_ >= 0 ? pricerData->maxCols_ : INT_MAX;
+    bool checkExisting = pricerData->nAltDuals_ > 0 || SCIPhasPooledColumns(scip, probData);
+    vector<pair<int, int>> cands;
+    int day, k;
+
+    if(pricerData->isSmoothed_)
+        pricerData->setSubgradient(modelData, tours, redCosts);
+
+    /* collect all candidate tours */
+    for(day = 0; day < modelData->nDays; day++)
+    {
+        if(pricerData->fixedDay_[day])
+            continue;
+        assert(tours[day].size() == redCosts[day].size());
+        for(k = 0; k < (int) tours[day].size(); k++)
+        {
+            tourVRP& tvrp = tours[day][k];
+            assert(tvrp.length_ > 0);
+            /* tours of smoothed duals are only added if their reduced costs w.r.t. the LP duals are negative */
+            if(pricerData->isSmoothed_)
+            {
+                redCosts[day][k] = pricerData->getLPRedCosts(modelData, tvrp, redCosts[day][k]);
+                if(!SCIPisSumNegative(scip, redCosts[day][k]))
+                    continue;
+            }
+            /* check for ng-path violations */
+            if(USE_DSSR)
+            {
+                if(violatesNGProperty(modelData->ng_set, pricerData->ng_DSSR_, tvrp.tour_))
+                    continue;
+            }
+            /* tours of additional dual vectors might already be part of the master problem, and pooled columns
+             * with negative reduced costs are added back to the LP by SCIP itself */
+            if(checkExisting)
+            {
+                SCIP_Var* existingVar = nullptr;
+                if(SCIPcontainsTourVar(scip, probData, &existingVar, tvrp))
+                    continue;
+            }
+            cands.emplace_back(day, k);
+        }
+    }
+
+    /* greedy max-coverage: the score of a tour is its reduced costs weighted by its share of uncovered customers.
+     * If all remaining tours only visit covered customers, a new round with no covered customers is started. */
+    vector<bool> covered(modelData->nC, false);
+    vector<bool> isSelected(cands.size(), false);
+    vector<int> nSelected(modelData->nDays, 0);
+    vector<tourVRP*> selected;
+    int nAdded = 0;
+    bool newRound = true;
+    while(nAdded < maxTotal)
+    {
+        int best = -1;
+        double bestScore = 0.0;
+        bool candsLeft = false;
+        for(k = 0; k < (int) cands.size(); k++)
+        {
+            day = cands[k].first;
+            if(isSelected[k] || nSelected[day] >= maxPerDay)
+                continue;
+            candsLeft = true;
+            tourVRP& tvrp = tours[day][cands[k].second];
+            int nUncovered = 0;
+            for(auto u : tvrp.tour_)
+            {
+                if(!covered[u])
+                    nUncovered++;
+            }
+            double score = -redCosts[day][cands[k].second] * nUncovered / tvrp.length_;
+            if(score > bestScore)
+            {
+                best = k;
+                bestScore = score;
+            }
+        }
+        if(best == -1)
+        {
+            if(!candsLeft || newRound)
+                break;
+            covered.assign(modelData->nC, false);
+            newRound = true;
+            continue;
+        }
+        newRound = false;
+        day = cands[best].first;
+        tourVRP& tvrp = tours[day][cands[best].second];
+        for(auto u : tvrp.tour_)
+            covered[u] = true;
+        isSelected[best] = true;
+        nSelected[day]++;
+        nAdded++;
+        selected.push_back(&tvrp);
+    }
+    SCIP_CALL(add_tour_variables(scip, probData, isFarkas, algoName, selected));
+
+    /* the remaining candidates are kept for the restricted master heuristic */
+    auto* heurData = dynamic_cast<HeurRestrictedMaster *>(SCIPfindObjHeur(scip, "restrictedMaster"));
+    if(heurData != nullptr)
+    {
+        for(k = 0; k < (int) cands.size(); k++)
+        {
+            if(!isSelected[k])
+                heurData->addPoolTour(modelData, tours[cands[k].first][cands[k].second]);
+        }
+    }
+
+    return SCIP_OKAY;
+}
+
 static
 void *labeling_thread(void *arguments){
     auto* args = static_cast<arg_struct *>(arguments);
 
     assert(args->modelData != nullptr);
 
-    generateLabelsBiDir(args->scip, args->modelData, args->pricerData, *args->bestTours,
-                     args->isFarkas, args->getDayVarRed, args->isHeuristic, args->noDomiance, args->day);
+    generateLabelsBiDir(args->scip, args->modelData, args->pricerData, *args->bestTours, *args->bestRedCosts,
+                     args->getDayVarRed, args->isHeuristic, args->excludeTour, args->day);
 //    generateLabels(args->scip, args->modelData, args->pricerData, args->bestLabels,
 //                   args->isFarkas, args->isHeuristic, args->day);
 //    printf("Thread for day %d: Ended.\n", args->day);
@@ -465,9 +941,10 @@ SCIP_RETCODE labelingAlgorithmnParallel(
     arg_struct* thread_args;
     int result_code;
     int i;
-    char algoName[] = "pricingLabel";
 
     vector<vector<tourVRP>> tours(probData->getData()->nDays, vector<tourVRP>());
+    vector<vector<double>> redCosts(probData->getData()->nDays, vector<double>());
+    tourVRP* excludedTour = pricerData->getExcludedTour(scip);
     SCIP_CALL( SCIPallocMemoryArray(scip, &thread_args, modelData->nDays) );
     //create all threads one by one
     for (i = 0; i < modelData->nDays; i++) {
@@ -476,18 +953,13 @@ SCIP_RETCODE labelingAlgorithmnParallel(
         thread_args[i].scip = scip;
         thread_args[i].modelData = modelData;
         thread_args[i].pricerData = pricerData;
-        thread_args[i].isFarkas = isFarkas;
         thread_args[i].isHeuristic = isHeuristic;
         thread_args[i].getDayVarRed = getDayVarRed;
-        if(SCIPinProbing(scip) && i == pricerData->prop_tourfixing_->tvrp_.getDay())
-        {
-            thread_args[i].noDomiance = true;
-        }else
-        {
-            thread_args[i].noDomiance = false;
-        }
+        /* the probed tour must not be generated again */
+        thread_args[i].excludeTour = excludedTour != nullptr && i == excludedTour->getDay();
         thread_args[i].day = i;
         thread_args[i].bestTours = &tours[i];
+        thread_args[i].bestRedCosts = &redCosts[i];
 //        thread_args[i].bestTours = vector<tourVRP>();
         result_code = pthread_create(&threads[i], nullptr, labeling_thread, &thread_args[i]);
         assert(!result_code);
@@ -501,53 +973,9 @@ SCIP_RETCODE labelingAlgorithmnParallel(
         assert(!result_code);
     }
 
-    /* add the best labels as tours of each day to the master problem */
-    for(i = 0; i < modelData->nDays; i++)
-    {
-        if(pricerData->fixedDay_[i])
-            continue;
-
-        int count = 0;
-        for(auto& tvrp : *thread_args[i].bestTours)
-        {
-            if(SCIPinProbing(scip))
-            {
-                if(i == pricerData->prop_tourfixing_->tvrp_.getDay() && SCIPisEQ(scip, pricerData->prop_tourfixing_->tvrp_.obj_, tvrp.obj_)
-                   && pricerData->prop_tourfixing_->tvrp_.length_ == tvrp.length_)
-                {
-                    bool isfixtour = true;
-                    for(int j = 0; j < tvrp.length_; j++)
-                    {
-                        if(tvrp.tour_[j] != pricerData->prop_tourfixing_->tvrp_.tour_[j])
-                        {
-                            isfixtour = false;
-                            break;
-                        }
-                    }
-                    if(isfixtour)
-                    {
-//                            cout << "FOUND FIX TOUR (" << SCIPnodeGetNumber(SCIPgetFocusNode(scip)) << ")" << endl;
-                        continue;
-                    }
-                }
-            }
-            /* check for ng-path violations */
-            if(USE_DSSR)
-            {
-                if(violatesNGProperty(probData->getData()->ng_set, pricerData->ng_DSSR_, tvrp.tour_))
-                    continue;
-            }
-            assert(tvrp.length_ > 0);
-            SCIP_CALL(add_tour_variable(scip, probData, isFarkas, FALSE, algoName, tvrp));
+    /* add a diverse selection of the best tours of all days to the master problem */
+    SCIP_CALL(addSelectedTours(scip, probData, pricerData, tours, redCosts, isFarkas));
 
-            count++;
-            if(count > probData->getData()->nC / 4) // TODO: what is a good criteria?
-            {
-                break;
-            }
-        }
-
-    }
     SCIPfreeMemoryArray(scip, &thread_args);
 
     return SCIP_OKAY;
@@ -1,34 +1,39 @@
 
 #include "labellist.h"
 
+thread_local long long int LabelNode::nAlive_ = 0;
+
+/** marks the subtree of a dominated label as dead (iteratively, the nodes are removed lazily from their lists) and
+ *  returns the number of non-propagated labels in it; the label in propagation can already have children */
 static
-int deleteChildren2(
-        std::vector<LabelList*>&    activeLists,
-        std::vector<LabelList*>&    oldLists,
-        LabelNode*                  node,
-        LabelNode**                 next_node
+int markSubtreeDead(
+        LabelNode*                  node
 ){
-    int deleted_labels = 0;
-    LabelNode* child_node;
-    if(node->is_propagated_)
+    int dead_labels = 0;
+    std::vector<LabelNode*> stack;
+
+    node->is_dead_ = TRUE;
+    stack.push_back(node);
+    while(!stack.empty())
     {
-        child_node = node->child_;
-        while (child_node != nullptr)
+        LabelNode* curr_node = stack.back();
+        stack.pop_back();
+        for(LabelNode* child_node = curr_node->child_; child_node != nullptr; child_node = child_node->nextSib_)
         {
-            deleted_labels += deleteChildren2(activeLists, oldLists, child_node, next_node);
-            child_node = node->child_;
+            /* subtrees of dead nodes are already marked */
+            if(child_node->is_dead_)
+                continue;
+            child_node->is_dead_ = TRUE;
+            if(!child_node->is_propagated_)
+                dead_labels++;
+            if(child_node->child_ != nullptr)
+                stack.push_back(child_node);
         }
-        *next_node = node->next_;
-        oldLists[node->label2_->current_]->delete_node(node);
-
-        return deleted_labels;
-    }else
-    {
-        activeLists[node->label2_->current_]->delete_node(node);
-        return 1;
     }
+    return dead_labels;
 }
 
+template<bool withSRC, bool withEC>
 int dominance_check2(
         std::vector<LabelList*>&    activeLists,
         std::vector<LabelList*>&    oldLists,
@@ -41,13 +46,9 @@ int dominance_check2(
     LabelNode* tmp_node;
     LabelNode* next_node;
     int count = 0;
+    LabelList* list = usedLabels ? oldLists[label->current_] : activeLists[label->current_];
 
-    if(!usedLabels)
-    {
-        tmp_node = activeLists[label->current_]->head_;
-    }else{
-        tmp_node = oldLists[label->current_]->head_;
-    }
+    tmp_node = list->head_;
 
     while (tmp_node != nullptr)
     {
@@ -56,30 +57,48 @@ int dominance_check2(
         next_node = tmp_node->next_;
         if(next_node != nullptr)
             assert(next_node != next_node->next_);
+        /* labels of dominated subtrees are removed on the way */
+        if(tmp_node->is_dead_)
+        {
+            list->remove_dead(tmp_node);
+            tmp_node = next_node;
+            continue;
+        }
         /* new label gets dominated by an already existing one */
-        if(tmp_node->label2_->dominates(label, pricerData, scip))
+        if(tmp_node->label2_->dominates<withSRC, withEC>(label, pricerData, scip))
         {
             assert(count == 0);
             return -1;
         }
             /* new label dominates an already existing one */
-        else if (label->dominates(tmp_node->label2_, pricerData, scip))
+        else if (label->dominates<withSRC, withEC>(tmp_node->label2_, pricerData, scip))
         {
             /* just delete label if it is non-propagated */
             if(!usedLabels)
             {
                 count++;
-                activeLists[label->current_]->delete_node(tmp_node);
+                tmp_node->is_dead_ = TRUE;
             }
-                /* delete label and its descendants */
+                /* mark label and its descendants as dead */
             else
             {
-                count += deleteChildren2(activeLists, oldLists, tmp_node, &next_node);
+                count += markSubtreeDead(tmp_node);
             }
+            list->remove_dead(tmp_node);
         }
 
         tmp_node = next_node;
     }
 
     return count;
-}
\ No newline at end of file
+}
+
+/* dominance checks for each resource configuration */
+template int dominance_check2<false, false>(std::vector<LabelList*>&, std::vector<LabelList*>&, Label2*, SCIP_Bool,
+                                            ObjPricerVRP*, SCIP*);
+template int dominance_check2<false, true>(std::vector<LabelList*>&, std::vector<LabelList*>&, Label2*, SCIP_Bool,
+                                           ObjPricerVRP*, SCIP*);
+template int dominance_check2<true, false>(std::vector<LabelList*>&, std::vector<LabelList*>&, Label2*, SCIP_Bool,
+                                           ObjPricerVRP*, SCIP*);
+template int dominance_check2<true, true>(std::vector<LabelList*>&, std::vector<LabelList*>&, Label2*, SCIP_Bool,
+                                          ObjPricerVRP*, SCIP*);
@@ -6,6 +6,7 @@
 #include "probdata_vrp.h"
 #include "tools_vrp.h"
 #include "tourVRP.h"
+#include "var_tools.h"
 
 using namespace std;
 
@@ -14,7 +15,7 @@ bool addNodeToTourPricing(
         SCIP*                               scip,
         model_data*                         modelData,
         tourVRP&                            tvrp,
-        const vector<vector<bool>>&         isForbidden,
+        const bit_matrix&                   isForbidden,
         int                                 cust,
         int                                 *newpos,
         SCIP_Real                           threshold
@@ -24,8 +25,8 @@ bool addNodeToTourPricing(
     double extracosts;                              // costs of adding the customer
     double bestcosts = threshold;
     int bestpos = -1;
-    vector<vector<double>>& tr = modelData->travel;
-    vector<vector<timeWindow>>& tws = modelData->timeWindows;
+    travel_matrix& tr = modelData->travel;
+    customer_day_table<timeWindow>& tws = modelData->timeWindows;
 
     /* initialize with new customer at first position */
     tmpTour.length_--;
@@ -394,10 +395,10 @@ bool investigateColumn(
 
     /* get vardata */
     auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
-    if(pricerData->fixedDay_[vardata->tourVrp_.getDay()])
+    if(pricerData->fixedDay_[vardata->getDay()])
         return false;
 
-    tvrp.copy(vardata->tourVrp_);
+    vardata->getTourVRP(tvrp);
     assert(tvrp.isFeasible(modelData));
     day = tvrp.getDay();
     lhs = dualValues[modelData->nC + day];
@@ -523,15 +524,17 @@ SCIP_RETCODE localSearchPricing(
     vector<tourVRP> new_tours;
 //    vector<vector<pair<int, SCIP_Real>>> toCheck(modelData->nDays, vector<pair<int, SCIP_Real>>());
 
-    vector<pair<int, SCIP_Real>> primary_vars; // variables with lp value > 0
-    vector<pair<int, SCIP_Real>> backup_vars; //TODO: Maybe include other variables
+    vector<pair<SCIP_VAR*, SCIP_Real>> primary_vars; // variables with lp value > 0
+    vector<pair<SCIP_VAR*, SCIP_Real>> backup_vars; //TODO: Maybe include other variables
+    SCIP_COL** cols = SCIPgetLPCols(scip);
 
     double num_v = 0.0;
-    for(i = 0; i < probData->nVars_; i++)
+    for(i = 0; i < SCIPgetNLPCols(scip); i++)
     {
-        if(SCIPvarGetUbLocal(probData->vars_[i]) < 0.5)
+        SCIP_VAR* var = SCIPcolGetVar(cols[i]);
+        if(SCIPvarGetUbLocal(var) < 0.5)
             continue;
-        lpval = SCIPvarGetLPSol(probData->vars_[i]);
+        lpval = SCIPvarGetLPSol(var);
 
         if(SCIPisSumPositive(scip, lpval - 1)) // For Farkas Pricing
             continue;
@@ -540,13 +543,13 @@ SCIP_RETCODE localSearchPricing(
         if(SCIPisSumPositive(scip, lpval))
         {
             /* only search for elementary tours */
-            if(!dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, probData->vars_[i]))->isElementary())
+            if(!dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var))->isElementary())
                 continue;
-            assert(SCIPvarGetUbLocal(probData->vars_[i]) > 0.5);
-            primary_vars.emplace_back(i, lpval);
+            assert(SCIPvarGetUbLocal(var) > 0.5);
+            primary_vars.emplace_back(var, lpval);
         }else
         {
-//            backup_vars.emplace_back(i, SCIPgetVarRedcost(scip, probData->vars_[i]));
+//            backup_vars.emplace_back(var, SCIPgetVarRedcost(scip, var));
         }
     }
 //    cout << "NUMBER OF VEHICLE IN FRAC: " << num_v << '\n';
@@ -563,9 +566,7 @@ SCIP_RETCODE localSearchPricing(
     num_found = 0;
     for(i = 0; i < (int) primary_vars.size(); i++)
     {
-        int var_index = primary_vars[i].first;
-        assert(var_index >= 0 && var_index < probData->nVars_);
-        if(investigateColumn(scip, pricerData, modelData, isFarkas, probData->vars_[var_index], dualValues, new_tours))
+        if(investigateColumn(scip, pricerData, modelData, isFarkas, primary_vars[i].first, dualValues, new_tours))
         {
             num_found++;
         }
@@ -573,10 +574,105 @@ SCIP_RETCODE localSearchPricing(
         if(num_found == MAX_LOCALSEARCH_TOURS)
             break;
     }
+    bool hasPool = SCIPhasPooledColumns(scip, probData);
+    vector<tourVRP*> found;
     for(i = 0; i < num_found; i++)
     {
-        add_tour_variable(scip, probData, isFarkas, FALSE, algoName, new_tours[i]);
+        /* pooled columns with negative reduced costs are added back to the LP by SCIP itself */
+        SCIP_Var* existingVar = nullptr;
+        if(hasPool && SCIPcontainsTourVar(scip, probData, &existingVar, new_tours[i]))
+            continue;
+        found.push_back(&new_tours[i]);
     }
+    SCIP_CALL(add_tour_variables(scip, probData, isFarkas, algoName, found));
 
     return SCIP_OKAY;
-}
\ No newline at end of file
+}
+
+/** Farkas pricing heuristic
+ *
+ *  The customers with positive Farkas duals are the ones the infeasible master cannot cover. As in the initial
+ *  dispatching, they are inserted at their cheapest feasible position into new routes of the open days, the enforced
+ *  customers of a day first. Each route with negative Farkas price is added.
+ */
+SCIP_RETCODE farkasCoveringPricing(
+        SCIP*                       scip,
+        ObjPricerVRP*               pricerData,
+        vrp::ProbDataVRP*           probData,
+        const vector<SCIP_Real>&    dualValues
+){
+    char algoName[] = "farkasCoveringPricing";
+    model_data* modelData = probData->getData();
+    vector<pair<int, SCIP_Real>> uncovered;
+    vector<bool> isCovered(modelData->nC, false);
+    vector<tourVRP> new_tours;
+    int day, k, u;
+
+    /* same masks as in the labeling: the global ones at the root, otherwise the ones of the node combined with them */
+    bit_matrix timetable;
+    bit_matrix isForbidden;
+    if(pricerData->atRoot_)
+    {
+        timetable = pricerData->global_timetable_;
+        isForbidden = pricerData->global_isForbidden_;
+    }else
+    {
+        timetable.assignAnd(pricerData->timetable_, pricerData->global_timetable_);
+        isForbidden.assignOr(pricerData->isForbidden_, pricerData->global_isForbidden_);
+    }
+
+    for(u = 1; u < modelData->nC; u++)
+    {
+        if(SCIPisSumPositive(scip, dualValues[u]))
+            uncovered.emplace_back(u, dualValues[u]);
+    }
+    if(uncovered.empty())
+        return SCIP_OKAY;
+    sort(uncovered.begin(), uncovered.end(), [](auto &left, auto &right){
+        return left.second > right.second;
+    });
+
+    for(day = 0; day < modelData->nDays; day++)
+    {
+        if(pricerData->fixedDay_[day])
+            continue;
+        for(k = 0; k < modelData->num_v[day]; k++)
+        {
+            tourVRP tvrp(0, day);
+            if(pricerData->nEC_[day] > 0)
+            {
+                for(u = 1; u < modelData->nC; u++)
+                {
+                    if(pricerData->eC_[u] == day)
+                        addNodeToTourPricing(scip, modelData, tvrp, isForbidden, u, nullptr, SCIP_DEFAULT_INFINITY);
+                }
+            }
+            for(auto& cust : uncovered)
+            {
+                u = cust.first;
+                if(isCovered[u] || !timetable[u][day] || pricerData->eC_[u] == day)
+                    continue;
+                if(tvrp.capacity_ + modelData->demand[u] > modelData->max_caps[day])
+                    continue;
+                addNodeToTourPricing(scip, modelData, tvrp, isForbidden, u, nullptr, SCIP_DEFAULT_INFINITY);
+            }
+            if(tvrp.length_ == 0)
+                break;
+            if(!SCIPisSumNegative(scip, pricerData->getTourVRPredcosts(tvrp)))
+                break;
+            SCIP_Var* existingVar = nullptr;
+            if(SCIPcontainsTourVar(scip, probData, &existingVar, tvrp))
+                break;
+            for(auto v : tvrp.tour_)
+                isCovered[v] = true;
+            new_tours.push_back(tvrp);
+        }
+    }
+
+    vector<tourVRP*> found;
+    for(auto& tvrp : new_tours)
+        found.push_back(&tvrp);
+    SCIP_CALL(add_tour_variables(scip, probData, TRUE, algoName, found));
+
+    return SCIP_OKAY;
+}
@@ -25,6 +25,9 @@
 #include "eventhdlr_nodeInit.hpp"
 #include "printer.h"
 #include "heurDayVarRounding.h"
+#include "heurALNS.h"
+#include "heurRestrictedMaster.h"
+#include "heurPriceAndDive.h"
 #include "prop_varfixing.h"
 #include "prop_tourvarfixing.h"
 
@@ -42,7 +45,8 @@ SCIP_RETCODE readArguments(
     char**              input_file,
     int*                dayVarBranching,
     int*                activate_propagator,
-    int*                seed
+    int*                seed,
+    int*                setCovering
 )
 {
     char usage[SCIP_MAXSTRLEN];
@@ -132,6 +136,27 @@ SCIP_RETCODE readArguments(
                 return SCIP_ERROR;
             }
             free(locstr);
+        }else if ( ! strcmp(argv[i], "-c"))
+        {
+            if( i == argc - 1 || (! strncmp(argv[i+1], "-",1)))
+            {
+                fprintf(stderr, "Missing master formulation. ");
+                SCIPerrorMessage("%s\n", usage);
+                return SCIP_ERROR;
+            }
+            i++;
+            locstr = (char *) malloc ( (int)strlen(argv[i]) * sizeof(char) +1 );
+            strcpy(locstr, argv[i]);
+            *setCovering = atoi(locstr);
+            if(*setCovering != 0 && *setCovering != 1)
+            {
+                fprintf(stderr, "Invalid master formulation -> Choose 1 for set covering and 0 for set partitioning. ");
+                SCIPerrorMessage("%s\n", usage);
+                return SCIP_ERROR;
+            }
+            free(locstr);
+            if(*setCovering == 1)
+                cout << "USE SET COVERING MASTER!" << endl;
         }
     }
 
@@ -178,6 +203,9 @@ SCIP_RETCODE setUpScip(
 
     /* include primal heuristics */
     SCIP_CALL(SCIPincludeObjHeur(*scip, new HeurDayVarRounding(*scip), TRUE));
+    SCIP_CALL(SCIPincludeObjHeur(*scip, new HeurALNS(*scip), TRUE));
+    SCIP_CALL(SCIPincludeObjHeur(*scip, new HeurRestrictedMaster(*scip), TRUE));
+    SCIP_CALL(SCIPincludeObjHeur(*scip, new HeurPriceAndDive(*scip), TRUE));
 
     /* include event handler */
     SCIP_CALL(SCIPincludeObjEventhdlr(*scip, new EventhdlrNodeInit(*scip), TRUE));
@@ -217,6 +245,11 @@ SCIP_RETCODE setUpScip(
     /* for column generation instances, disable restarts */
     SCIP_CALL( SCIPsetIntParam(*scip,"presolving/maxrestarts",0) );
 
+    /* column aging: the (removable) tour columns that stayed at zero in the LP for too many rounds are removed from
+     * the LP, also those of ancestor nodes, but stay in the problem as a pool that is priced by SCIP */
+    SCIP_CALL( SCIPsetIntParam(*scip,"lp/colagelimit",10) );
+    SCIP_CALL( SCIPsetBoolParam(*scip,"lp/cleanupcols",TRUE) );
+
     /* activate reduced costs propagator */
 //    SCIP_CALL(SCIPsetBoolParam(*scip, "propagating/redcost/force", true));
 
@@ -246,14 +279,15 @@ SCIP_RETCODE addInitTours(
 {
     char algoName[] = "initTour";
     auto* probData = dynamic_cast<vrp::ProbDataVRP*>(SCIPgetObjProbData(scip));
-    for(auto var : probData->vars_)
+    vector<tourVRP> tours;
+    bool repaired;
+    bool success;
+    SCIP_CALL(getPartitioningTours(scip, probData, SCIPgetBestSol(scip), tours, &repaired, &success));
+    if(!success)
+        cout << "Solution could not be repaired to set partitioning, no warm start." << endl;
+    for(auto& tvrp : tours)
     {
-        if(SCIPgetSolVal(scip, SCIPgetBestSol(scip), var) < 0.5)
-            continue;
-        tourVRP tvrp;
-        auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
-        tvrp.copy(vardata->tourVrp_);
-        tvrp.setDay(hash_day[vardata->getDay()]);
+        tvrp.setDay(hash_day[tvrp.getDay()]);
         SCIP_CALL(add_tour_variable(scip_new, dynamic_cast<vrp::ProbDataVRP*>(SCIPgetObjProbData(scip_new)),
                                     FALSE, TRUE, algoName, tvrp));
     }
@@ -315,17 +349,21 @@ SCIP_RETCODE outputSolution(
     ofstream solfile;
     solfile.open(outfile, std::ios_base::app);
     cout << "PRINT SOLUTION: " << outfile << endl;
-    SCIP_Sol* sol = SCIPgetBestSol(scip);
-    for(auto var : probData->vars_)
+    vector<tourVRP> tours;
+    bool repaired;
+    bool success;
+    SCIP_CALL(getPartitioningTours(scip, probData, SCIPgetBestSol(scip), tours, &repaired, &success));
+    if(!success)
     {
-        if(SCIPgetSolVal(scip, sol, var) > 0.5)
-        {
-            tourVRP tvrp = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var))->tourVrp_;
-            solfile << tvrp.getDay() << " " << tvrp.obj_ << " " << tvrp.capacity_ << " " << tvrp.length_;
-            for(auto v : tvrp.tour_)
-                solfile << " " << v;
-            solfile << endl;
-        }
+        SCIPerrorMessage("solution could not be repaired to set partitioning\n");
+        return SCIP_ERROR;
+    }
+    for(auto& tvrp : tours)
+    {
+        solfile << tvrp.getDay() << " " << tvrp.obj_ << " " << tvrp.capacity_ << " " << tvrp.length_;
+        for(auto v : tvrp.tour_)
+            solfile << " " << v;
+        solfile << endl;
     }
 
     return SCIP_OKAY;
@@ -377,8 +415,9 @@ SCIP_RETCODE runColumnGenerationModel(
     int ng_parameter = 8;
     int activate_propagator = 0;
     int seed = 0;
+    int setCovering = 0;
 
-    SCIP_CALL(readArguments(argc, argv, &input_file, &dayVarBranching, &activate_propagator, &seed));
+    SCIP_CALL(readArguments(argc, argv, &input_file, &dayVarBranching, &activate_propagator, &seed, &setCovering));
 
     string s(input_file);
     string s1 = s.substr(s.find('_')-2, -1 );
@@ -390,6 +429,7 @@ SCIP_RETCODE runColumnGenerationModel(
 
     SCIP_CALL(getModelDataFromJson(modelData, input_file, ng_parameter));
     modelData->minTravel = true;
+    modelData->setCovering = setCovering == 1;
 
     vector<tourVRP> sol_tvrps;
 
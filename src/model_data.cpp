@@ -14,19 +14,20 @@ using json = nlohmann::json;
 
 static
 SCIP_RETCODE getTimeWindows(
-        model_data*     modelData,
-        json::iterator& it,
-        int             customer
+        model_data*                         modelData,
+        json::iterator&                     it,
+        int                                 customer,
+        vector<pair<int, timeWindow>>&      windows
 ){
     int day;
     for(auto& it2 : it.value())
     {
         day = it2.value("day", -1);
-        modelData->timeWindows[customer][day].day = day;
-        modelData->timeWindows[customer][day].start = it2.value("start", 0);
-        modelData->timeWindows[customer][day].end = it2.value("end", 0);
-        if(modelData->timeWindows[customer][day].end > 0)
+        timeWindow tw = {day, it2.value("start", 0), it2.value("end", 0)};
+        /* only the windows of available days are stored */
+        if(tw.end > 0)
         {
+            windows.emplace_back(day, tw);
             modelData->availableDays[customer].push_back(day);
             for(int i = modelData->firstVehicleofday[day]; i < modelData->firstVehicleofday[day+1]; i++)
                 modelData->availableVehicles[customer].push_back(i);
@@ -42,17 +43,20 @@ SCIP_RETCODE getTravelTimes(
         std::vector<double>&    y,
         model_data*             modelData
 ){
-    double tmp;
+    int n = (int) x.size();
     assert(x.size() == y.size());
-    for(int i = 0; i < int(x.size()); i++)
+    vector<double> row(n);
+    for(int i = 0; i < n; i++)
     {
-        for(int j = i; j < int(y.size()); j++)
+        /* whole row at once without calls to pow, such that the loop can be vectorised */
+        for(int j = 0; j < n; j++)
         {
-            tmp = sqrt(pow(x[i]-x[j], 2.0) + pow(y[i]-y[j], 2.0));
-            tmp = round(tmp * ROUNDING_FACTOR) / ROUNDING_FACTOR;
-            modelData->travel[i][j] = tmp;
-            modelData->travel[j][i] = tmp;
+            double dx = x[i] - x[j];
+            double dy = y[i] - y[j];
+            row[j] = round(sqrt(dx * dx + dy * dy) * ROUNDING_FACTOR) / ROUNDING_FACTOR;
         }
+        for(int j = SYMMETRIC_TRAVEL ? i : 0; j < n; j++)
+            modelData->travel[i][j] = (travel_t) row[j];
     }
     return SCIP_OKAY;
 }
@@ -62,38 +66,47 @@ SCIP_RETCODE setNeighborhood(
         model_data*     modelData
 ){
     double earliest_arrival;
+    vector<vector<vector<int>>> neighbors(modelData->nC, vector<vector<int>>(modelData->nDays));
+    vector<vector<vector<int>>> predecessors(modelData->nC, vector<vector<int>>(modelData->nDays));
+    /* customers available on each day, in increasing order */
+    vector<vector<int>> dayCustomers(modelData->nDays);
     for(int u = 0; u < modelData->nC; u++)
     {
-        for(int day = 0; day < modelData->nDays; day++)
+        for(int day : modelData->availableDays[u])
+            dayCustomers[day].push_back(u);
+    }
+    for(int day = 0; day < modelData->nDays; day++)
+    {
+        const vector<int>& customers = dayCustomers[day];
+        for(int i = 0; i < (int) customers.size(); i++)
         {
-            /* continue if u is not available on the day */
-            if(modelData->timeWindows[u][day].end == 0) continue;
-            for(int v = u+1; v < modelData->nC; v++)
+            int u = customers[i];
+            for(int j = i+1; j < (int) customers.size(); j++)
             {
-                /* continue if v is not available on the day */
-                if(modelData->timeWindows[v][day].end == 0) continue;
+                int v = customers[j];
                 /* check arc from u to v */
-                earliest_arrival = max(modelData->travel[0][u], (double) modelData->timeWindows[u][day].start) + modelData->service[u] + modelData->travel[u][v];
+                earliest_arrival = max((double) modelData->travel[0][u], (double) modelData->timeWindows[u][day].start) + modelData->service[u] + modelData->travel[u][v];
                 if(earliest_arrival <= modelData->timeWindows[v][day].end)
                 {
-                    modelData->adjacency_k[day][u][v] = true;
-                    modelData->neighbors[u][day].push_back(v);
+                    neighbors[u][day].push_back(v);
                     if(u > 0)
-                        modelData->predecessors[v][day].push_back(u);
+                        predecessors[v][day].push_back(u);
                 }
                 /* check arc from v to u */
-                earliest_arrival = max(modelData->travel[0][v], (double) modelData->timeWindows[v][day].start) + modelData->service[v] + modelData->travel[v][u];
+                earliest_arrival = max((double) modelData->travel[0][v], (double) modelData->timeWindows[v][day].start) + modelData->service[v] + modelData->travel[v][u];
                 if(earliest_arrival <= modelData->timeWindows[u][day].end)
                 {
-                    modelData->adjacency_k[day][v][u] = true;
                     if(u > 0)
-                        modelData->neighbors[v][day].push_back(u);
-                    modelData->predecessors[u][day].push_back(v);
+                        neighbors[v][day].push_back(u);
+                    predecessors[u][day].push_back(v);
                 }
 
             }
         }
     }
+    /* pack the lists */
+    modelData->neighbors.init(neighbors);
+    modelData->predecessors.init(predecessors);
     return SCIP_OKAY;
 }
 
@@ -145,6 +158,7 @@ SCIP_RETCODE getModelDataFromJson(
     modelData->nC = nC;
     modelData->nDays = nDays;
     modelData->minTravel = false;
+    modelData->setCovering = false;
 
     std::cout << "nCustomers: " << nC << " nDays: " << nDays << '\n';
 
@@ -162,16 +176,11 @@ SCIP_RETCODE getModelDataFromJson(
     std::vector<double> x(nC);
     std::vector<double> y(nC);
     /* travel times */
-    modelData->travel.resize(nC, std::vector<double>(nC));
-    /* time windows */
-    modelData->timeWindows.resize(nC, std::vector<timeWindow>(nDays));
+    modelData->travel.resize(nC);
+    /* time windows (packed after reading) */
+    vector<vector<pair<int, timeWindow>>> windows(nC);
     /* available days */
     modelData->availableDays.resize(nC, std::vector<int>());
-    /* neighbors and predecessors */
-    modelData->neighbors.resize(nC, std::vector<std::vector<int>>(nDays));
-    modelData->predecessors.resize(nC, std::vector<std::vector<int>>(nDays));
-    /* adjacency matrices */
-    modelData->adjacency_k.resize(nDays, vector<vector<bool>>(nC, vector<bool>(nC, false)));
     /* ng-neighbors */
     modelData->ng_set.resize(nC, bitset<neighborhood_size>());
 
@@ -216,12 +225,13 @@ SCIP_RETCODE getModelDataFromJson(
         it2++;
         assert(it2.key() == "windows");
         assert(!it2->empty());
-        SCIP_CALL( getTimeWindows(modelData, it2, k) );
+        SCIP_CALL( getTimeWindows(modelData, it2, k, windows[k]) );
 
         it++;
         k++;
     }
     assert(k == nC);
+    modelData->timeWindows.init(windows, {-1, 0, 0});
 
     /* calculate travel times */
     SCIP_CALL( getTravelTimes(x, y, modelData) );
@@ -257,12 +267,13 @@ SCIP_RETCODE transformModelData
     /** get new data */
     modelData_new->nDays = num_days;
     modelData_new->minTravel = true;
+    modelData_new->setCovering = modelData_old->setCovering;
     /* time windows */
-    modelData_new->timeWindows.resize(modelData_new->nC, std::vector<timeWindow>(num_days));
+    vector<vector<pair<int, timeWindow>>> windows(modelData_new->nC);
     /* available days */
     modelData_new->availableDays.resize(modelData_new->nC, std::vector<int>());
     /* neighbors */
-    modelData_new->neighbors.resize(modelData_new->nC, std::vector<std::vector<int>>(num_days));
+    vector<vector<vector<int>>> neighbors(modelData_new->nC, vector<vector<int>>(num_days));
 
     /* built hash map for days */
 
@@ -279,18 +290,18 @@ SCIP_RETCODE transformModelData
     }
     for(int cust = 0; cust < modelData_new->nC; cust++)
     {
-        for(int day = 0; day < modelData_old->nDays; day++)
+        for(int day : modelData_old->availableDays[cust])
         {
             if(hash_day[day] == -1)
                 continue;
-            if(modelData_old->timeWindows[cust][day].end > 0)
-            {
-                modelData_new->timeWindows[cust][hash_day[day]] = modelData_old->timeWindows[cust][day];
-                modelData_new->availableDays[cust].push_back(hash_day[day]);
-                modelData_new->neighbors[cust][hash_day[day]] = modelData_old->neighbors[cust][day];
-            }
+            windows[cust].emplace_back(hash_day[day], modelData_old->timeWindows[cust][day]);
+            modelData_new->availableDays[cust].push_back(hash_day[day]);
+            auto nbs = modelData_old->neighbors[cust][day];
+            neighbors[cust][hash_day[day]].assign(nbs.begin(), nbs.end());
         }
     }
+    modelData_new->timeWindows.init(windows, {-1, 0, 0});
+    modelData_new->neighbors.init(neighbors);
 
     return SCIP_OKAY;
 }
@@ -1,6 +1,7 @@
 
 #include "pricer_vrp.h"
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -12,6 +13,7 @@
 #include "local_search_pricing.h"
 #include "vardata.h"
 #include "tools_vrp.h"
+#include "var_tools.h"
 #include "ConshdlrArcflow.h"
 #include "ConshdlrDayVar.h"
 #include "ConshdlrKPC.h"
@@ -19,6 +21,8 @@
 #include "ConshdlrNVehicle.h"
 #include "ConshdlrVehicle.h"
 #include "heurDayVarRounding.h"
+#include "heurALNS.h"
+#include "heurRestrictedMaster.h"
 #include "printer.h"
 #include "ctime"
 
@@ -149,10 +153,7 @@ SCIP_RETCODE setTimeTable(
             assert(pricerData->timetable_[customer][day]); // TODO: bugfix_n30_p0.5_49
 
             /* Set row except for the enforced day to FALSE */
-            for (int j : modelData->availableDays[customer]) {
-                assert(0 <= j && j < modelData->nDays);
-                pricerData->timetable_[customer][j] = false;
-            }
+            pricerData->timetable_.resetRow(customer);
             pricerData->timetable_[customer][day] = true;
         }
         else
@@ -326,16 +327,16 @@ SCIP_RETCODE setCurrentNeighborhood(
     assert(pricerData != nullptr);
     assert(modelData != nullptr);
 
-    vector<vector<bool>>& timetable = atRoot ? pricerData->global_timetable_ : pricerData->timetable_;
-    vector<vector<bool>>& isForbidden = atRoot ? pricerData->global_isForbidden_ : pricerData->isForbidden_;
+    bit_matrix& timetable = atRoot ? pricerData->global_timetable_ : pricerData->timetable_;
+    bit_matrix& isForbidden = atRoot ? pricerData->global_isForbidden_ : pricerData->isForbidden_;
 
     for(int u = 0; u < modelData->nC; u++)
     {
         for (int day = 0; day < modelData->nDays; day++)
         {
             /* clear old data */
-            pricerData->neighbors_[u][day].clear();
-            pricerData->predecessors_[u][day].clear();
+            pricerData->neighbors_.clear(u, day);
+            pricerData->predecessors_.clear(u, day);
 
             /* contine if customer is not available on day (possibly due to branching decisions) */
             if(!(timetable[u][day] && pricerData->global_timetable_[u][day]))
@@ -348,7 +349,7 @@ SCIP_RETCODE setCurrentNeighborhood(
                     continue;
                 if(!(isForbidden[u][nb] || pricerData->global_isForbidden_[u][nb]))
                 {
-                    pricerData->neighbors_[u][day].push_back(nb);
+                    pricerData->neighbors_.push_back(u, day, nb);
                 }
             }
             /* check for each predecessor if it is forbidden */
@@ -358,7 +359,7 @@ SCIP_RETCODE setCurrentNeighborhood(
                     continue;
                 if(!(isForbidden[pd][u] || pricerData->global_isForbidden_[pd][u]))
                 {
-                    pricerData->predecessors_[u][day].push_back(pd);
+                    pricerData->predecessors_.push_back(u, day, pd);
                 }
             }
         }
@@ -369,8 +370,7 @@ SCIP_RETCODE setCurrentNeighborhood(
 /** Sets the initial ng_dssr_data for the current branching node */
 static
 SCIP_RETCODE getParentsData(
-    ObjPricerVRP*           pricerData,
-    model_data*             modelData
+    ObjPricerVRP*           pricerData
 ){
     long long int parent_ID = SCIPnodeGetNumber(SCIPnodeGetParent(SCIPgetCurrentNode(pricerData->scip_)));
     node_data& nodeData = pricerData->tree_data_.at(parent_ID);
@@ -381,18 +381,9 @@ SCIP_RETCODE getParentsData(
     pricerData->fixedDay_ = nodeData.node_fixedDay_;
     pricerData->varfixing_gap_ = nodeData.node_varfixing_;
 
-    for(int u = 0; u < modelData->nC; u++)
-    {
-        for(int day = 0; day < modelData->nDays; day++)
-        {
-            pricerData->timetable_[u][day] = nodeData.node_timetable_[u][day] && pricerData->global_timetable_[u][day];
-        }
-        for(int v = u + 1; v < modelData->nC; v++)
-        {
-            pricerData->isForbidden_[u][v] = nodeData.node_isForbidden_[u][v] || pricerData->global_isForbidden_[u][v];
-            pricerData->isForbidden_[v][u] = nodeData.node_isForbidden_[v][u] || pricerData->global_isForbidden_[v][u];
-        }
-    }
+    /* combine node and global data word by word */
+    pricerData->timetable_.assignAnd(nodeData.node_timetable_, pricerData->global_timetable_);
+    pricerData->isForbidden_.assignOr(nodeData.node_isForbidden_, pricerData->global_isForbidden_);
 //        pricerData->timetable_ = nodeData.node_timetable_;
 //        pricerData->isForbidden_ = nodeData.node_isForbidden_;
 
@@ -409,6 +400,66 @@ SCIP_RETCODE getParentsData(
     return SCIP_OKAY;
 }
 
+/** sets the prize of the enforced customers for Farkas pricing
+ *
+ *  Instead of the big-M, the prize is derived from the arc prices of the day, including the arcs back to the depot: a
+ *  route that misses an enforced customer cannot collect more than the most negative arc price on each of its arcs, so
+ *  the prize keeps such routes from having negative Farkas prices while staying on the scale of the duals. Since
+ *  ng-routes need not be elementary, the number of arcs is bounded by the resources and not by nC: every visit uses at
+ *  least the minimal demand of the capacity and the minimal service time of the horizon. Only if neither resource is
+ *  consumed, nC arcs are assumed, which requires elementary routes.
+ */
+static
+void setFarkasEnforcedPrizes(
+        ObjPricerVRP*           pricerData,
+        model_data*             modelData
+){
+    for(int day = 0; day < modelData->nDays; day++)
+    {
+        if(pricerData->nEC_[day] == 0)
+            continue;
+        SCIP_Real maxGain = 0.0;
+        for(int u = 0; u < modelData->nC; u++)
+        {
+            SCIP_Real* prices = pricerData->arcPrices_.data() + pricerData->neighbors_.offset(u, day);
+            for(int a = 0; a < pricerData->neighbors_[u][day].size(); a++)
+                maxGain = max(maxGain, -prices[a]);
+            /* the arc back to the depot */
+            if(u > 0)
+                maxGain = max(maxGain, -pricerData->returnPrices_[u]);
+        }
+        int minDemand = INT_MAX;
+        int minService = INT_MAX;
+        for(int u = 1; u < modelData->nC; u++)
+        {
+            if(!pricerData->timetable_[u][day])
+                continue;
+            minDemand = min(minDemand, modelData->demand[u]);
+            minService = min(minService, modelData->service[u]);
+        }
+        int maxVisits = INT_MAX;
+        if(minDemand > 0 && minDemand != INT_MAX)
+            maxVisits = modelData->max_caps[day] / minDemand;
+        if(minService > 0 && minService != INT_MAX)
+            maxVisits = min(maxVisits, modelData->timeWindows[0][day].end / minService);
+        if(maxVisits == INT_MAX)
+            maxVisits = modelData->nC - 1;
+        SCIP_Real prize = 1.0 + (maxVisits + 1) * maxGain;
+        for(int u = 0; u < modelData->nC; u++)
+        {
+            day_adjacency::list_ref heads = pricerData->neighbors_[u][day];
+            SCIP_Real* prices = pricerData->arcPrices_.data() + pricerData->neighbors_.offset(u, day);
+            for(int a = 0; a < heads.size(); a++)
+            {
+                if(pricerData->eC_[heads[a]] == day)
+                    prices[a] -= prize;
+                if(u == 0)
+                    prices[a] += pricerData->nEC_[day] * prize;
+            }
+        }
+    }
+}
+
 /** Handles information of cuts for the pricing problem */
 static
 SCIP_RETCODE includeCuts(
@@ -439,15 +490,27 @@ SCIP_RETCODE includeCuts(
             continue;
         /* adjust prices for ingoing arcs of set S of conss[c] */
         vector<bool>& setS = SCIPgetSetOfKPC(conss[c]);
-        for(int i = 0; i < modelData->nC; i++)
+        for(int day = 0; day < modelData->nDays; day++)
         {
-            if(!setS[i]) /* i \in setS */
-                continue;
             for(int j = 0; j < modelData->nC; j++)
             {
                 if(setS[j]) /* j \notin setS */
                     continue;
-                pricerData->arcPrices_[j][i] -= dualvalue;
+                day_adjacency::list_ref heads = pricerData->neighbors_[j][day];
+                SCIP_Real* prices = pricerData->arcPrices_.data() + pricerData->neighbors_.offset(j, day);
+                for(int a = 0; a < heads.size(); a++)
+                {
+                    if(setS[heads[a]]) /* i \in setS */
+                        prices[a] -= dualvalue;
+                }
+            }
+        }
+        if(setS[0])
+        {
+            for(int j = 1; j < modelData->nC; j++)
+            {
+                if(!setS[j])
+                    pricerData->returnPrices_[j] -= dualvalue;
             }
         }
     }
@@ -566,6 +629,130 @@ SCIP_RETCODE checkPrimalHeuristic(
     return SCIP_OKAY;
 }
 
+/** adds the solution of a heuristic given by its tours, the columns of new tours are created */
+static
+SCIP_RETCODE addHeuristicSolution(
+   SCIP*                scip,
+   vrp::ProbDataVRP*    probData,
+   vector<tourVRP>&     tours,
+   const char*          heurName
+){
+    char algoName[SCIP_MAXSTRLEN];
+    SCIP_Bool isfeasible;
+    SCIP_SOL* sol;
+
+    (void) SCIPsnprintf(algoName, SCIP_MAXSTRLEN, "%s", heurName);
+    SCIP_CALL( SCIPcreateSol(scip, &sol, SCIPfindHeur(scip, heurName)) );
+    for(auto& t : tours)
+    {
+        if(t.length_ == 0)
+            continue;
+        SCIP_Var* existingVar = nullptr;
+        if(SCIPcontainsTourVar(scip, probData, &existingVar, t))
+        {
+            SCIP_CALL( SCIPsetSolVal(scip, sol, existingVar, 1.0) );
+        }else
+        {
+            SCIP_CALL(add_tour_variable(scip, probData, FALSE, FALSE, algoName, t));
+            SCIP_CALL( SCIPsetSolVal(scip, sol, probData->vars_[probData->nVars_ - 1], 1.0) );
+        }
+    }
+    SCIP_CALL( SCIPtrySolFree(scip, &sol, false, false, false, false, false, &isfeasible) );
+
+    return SCIP_OKAY;
+}
+
+/** adds the improved solution of the ALNS worker and hands new incumbents of SCIP to it */
+static
+SCIP_RETCODE checkALNSHeuristic(
+   SCIP*                scip,
+   vrp::ProbDataVRP*    probData
+){
+    auto* heurData = dynamic_cast<HeurALNS *>(SCIPfindObjHeur(scip, "vrpALNS"));
+    if(heurData == nullptr || !heurData->isRunning())
+        return SCIP_OKAY;
+
+    vector<tourVRP> tours;
+    if(heurData->getSolution(scip, tours, SCIPgetUpperbound(scip)))
+    {
+        SCIP_CALL(addHeuristicSolution(scip, probData, tours, "vrpALNS"));
+    }
+
+    /* the worker continues from the best solution of SCIP if it is better than its own */
+    SCIP_SOL* best = SCIPgetBestSol(scip);
+    if(best != nullptr && best != heurData->lastSol_)
+    {
+        bool repaired;
+        bool success;
+        heurData->lastSol_ = best;
+        tours.clear();
+        SCIP_CALL(getPartitioningTours(scip, probData, best, tours, &repaired, &success));
+        if(success)
+            heurData->setIncumbent(tours);
+    }
+
+    return SCIP_OKAY;
+}
+
+/** adds the solution of the restricted master heuristic if it needs new columns */
+static
+SCIP_RETCODE checkRestrictedMasterHeuristic(
+   SCIP*                scip,
+   vrp::ProbDataVRP*    probData
+){
+    auto* heurData = dynamic_cast<HeurRestrictedMaster *>(SCIPfindObjHeur(scip, "restrictedMaster"));
+    if(heurData == nullptr || heurData->sol_tours_.empty())
+        return SCIP_OKAY;
+
+    if(SCIPisSumNegative(scip, heurData->best_ - SCIPgetUpperbound(scip)))
+    {
+        SCIP_CALL(addHeuristicSolution(scip, probData, heurData->sol_tours_, "restrictedMaster"));
+    }
+    heurData->sol_tours_.clear();
+
+    return SCIP_OKAY;
+}
+
+/** repairs a new best solution of the set covering master that visits customers more than once */
+static
+SCIP_RETCODE repairPrimalSolution(
+    SCIP*                scip,
+    vrp::ProbDataVRP*    probData,
+    ObjPricerVRP*        pricerData
+){
+    SCIP_SOL* best = SCIPgetBestSol(scip);
+    if(!probData->getData()->setCovering || best == nullptr || SCIPsolGetIndex(best) == pricerData->lastRepairedSol_)
+        return SCIP_OKAY;
+    pricerData->lastRepairedSol_ = SCIPsolGetIndex(best);
+
+    vector<tourVRP> tours;
+    bool repaired;
+    bool success;
+    SCIP_CALL(getPartitioningTours(scip, probData, best, tours, &repaired, &success));
+    if(!repaired || !success)
+        return SCIP_OKAY;
+
+    char algoName[] = "repairedSol";
+    SCIP_Bool isfeasible;
+    SCIP_SOL* sol;
+    SCIP_CALL(SCIPcreateSol(scip, &sol, nullptr));
+    for(auto& t : tours)
+    {
+        SCIP_Var* existingVar = nullptr;
+        if(!SCIPcontainsTourVar(scip, probData, &existingVar, t))
+        {
+            SCIP_CALL(add_tour_variable(scip, probData, FALSE, FALSE, algoName, t));
+            existingVar = probData->vars_[probData->nVars_ - 1];
+        }
+        SCIP_CALL(SCIPsetSolVal(scip, sol, existingVar, 1.0));
+    }
+    SCIP_CALL( SCIPtrySolFree(scip, &sol, false, false, false, false, false, &isfeasible) );
+    /* the repaired solution is the new best one, unless it was found already */
+    pricerData->lastRepairedSol_ = SCIPsolGetIndex(SCIPgetBestSol(scip));
+
+    return SCIP_OKAY;
+}
+
 /** Process branching decisions of the new branching node to generate local instance */
 SCIP_RETCODE ObjPricerVRP::set_current_graph(
     model_data*     modelData
@@ -580,7 +767,7 @@ SCIP_RETCODE ObjPricerVRP::set_current_graph(
     }
 
     /* Set the initial parents data for the current branching node */
-    SCIP_CALL(getParentsData(this, modelData));
+    SCIP_CALL(getParentsData(this));
 
     /* process vehicle branching decisions */
     SCIP_CALL(setEnforcedDays(this));
@@ -608,8 +795,46 @@ ObjPricerVRP::ObjPricerVRP(
     ObjPricer(scip, p_name, "Finds tour with negative reduced cost.", 0, TRUE),
     cons_arcflow_(nullptr),
     cons_dayvar_(nullptr),
-    lastID_(1)
-{}
+    lastID_(1),
+    lastRepairedSol_(-1)
+{
+    maxColsPerDay_ = -1;
+    maxCols_ = -1;
+    maxCandsPerDay_ = 21;
+    nDualVectors_ = 1;
+    maxPairsPerDay_ = 11;
+    isSmoothed_ = false;
+    smoothingFactor_ = 0.5;
+    smoothingMaxTries_ = 3;
+    earlyBranchingGap_ = 0.0;
+    SCIPaddIntParam(scip, "pricers/VRP_Pricer/maxcolsperday", "maximal number of columns per day and pricing round "
+                    "(-1: nC/4 + 1)", &maxColsPerDay_, FALSE, -1, -1, INT_MAX, nullptr, nullptr);
+    SCIPaddIntParam(scip, "pricers/VRP_Pricer/maxcols", "maximal number of columns per pricing round "
+                    "(-1: unlimited)", &maxCols_, FALSE, -1, -1, INT_MAX, nullptr, nullptr);
+    SCIPaddIntParam(scip, "pricers/VRP_Pricer/maxcandsperday", "maximal number of candidate tours per day for the "
+                    "column selection", &maxCandsPerDay_, FALSE, 21, 1, INT_MAX, nullptr, nullptr);
+    SCIPaddIntParam(scip, "pricers/VRP_Pricer/maxpairsperday", "maximal number of concatenated label pairs per day "
+                    "(only without day var reduced costs)", &maxPairsPerDay_, FALSE, 11, 1, INT_MAX, nullptr, nullptr);
+    SCIPaddIntParam(scip, "pricers/VRP_Pricer/numdualvectors", "number of dual vectors per labeling pass, the "
+                    "additional ones combine the current and the last duals (1: only the current duals)",
+                    &nDualVectors_, FALSE, 1, 1, 64, nullptr, nullptr);
+    SCIPaddIntParam(scip, "pricers/VRP_Pricer/maxlabels", "number of live labels per thread after which the exact "
+                    "labeling shrinks the ng-sets; the bound stays valid but the columns might get non-elementary "
+                    "(-1: unlimited)", &maxLabels_, FALSE, -1, -1, INT_MAX, nullptr, nullptr);
+    SCIPaddIntParam(scip, "pricers/VRP_Pricer/heurmaxlabels", "number of live labels per thread after which the "
+                    "heuristic labeling uses a stricter dominance and stops at twice the number (-1: no heuristic "
+                    "labeling)", &heurMaxLabels_, FALSE, 1000000, -1, INT_MAX, nullptr, nullptr);
+    SCIPaddBoolParam(scip, "pricers/VRP_Pricer/smoothing", "should the duals be smoothed around a stability center "
+                     "(automatic smoothing factor)?", &useSmoothing_, FALSE, FALSE, nullptr, nullptr);
+    SCIPaddIntParam(scip, "pricers/VRP_Pricer/smoothingmaxtries", "maximal number of labelings with smoothed duals "
+                    "per pricing round before the exact pricing on the LP duals takes over", &smoothingMaxTries_, FALSE,
+                    3, 1, INT_MAX, nullptr, nullptr);
+    SCIPaddRealParam(scip, "pricers/VRP_Pricer/earlybranchinggap", "relative gap of LP value and Lagrangian bound "
+                     "below which column generation stops early at non-root nodes (0: off)", &earlyBranchingGap_, FALSE,
+                     0.0, 0.0, 1.0, nullptr, nullptr);
+    SCIPaddBoolParam(scip, "pricers/VRP_Pricer/farkascovering", "should Farkas pricing try the column pool and a "
+                     "covering heuristic before the labeling?", &useFarkasCovering_, FALSE, TRUE, nullptr, nullptr);
+}
 
 /** Destructs the pricer object. */
 ObjPricerVRP::~ObjPricerVRP()
@@ -624,37 +849,34 @@ SCIP_DECL_PRICERINIT(ObjPricerVRP::scip_init)
     model_data* modelData = probData->getData();
 
     /* initialize graph for pricing */
-    isForbidden_.resize(modelData->nC, vector<bool>(modelData->nC, true));
-    global_isForbidden_.resize(modelData->nC, vector<bool>(modelData->nC, true));
+    isForbidden_.resize(modelData->nC, modelData->nC, true);
+    global_isForbidden_.resize(modelData->nC, modelData->nC, true);
     toDepot_.resize(modelData->nC);
-    timetable_.resize(modelData->nC, vector<bool>(modelData->nDays, false));
-    global_timetable_.resize(modelData->nC, vector<bool>(modelData->nDays, false));
-    neighbors_.resize(modelData->nC, vector<vector<int>>(modelData->nDays));
-    predecessors_.resize(modelData->nC, vector<vector<int>>(modelData->nDays));
+    timetable_.resize(modelData->nC, modelData->nDays, false);
+    global_timetable_.resize(modelData->nC, modelData->nDays, false);
+    /* same layout as the global neighborhood, filtered in place at each node */
+    neighbors_ = modelData->neighbors;
+    predecessors_ = modelData->predecessors;
     for(int u = 0; u < modelData->nC; u++)
     {
         toDepot_[u] = TRUE;
-        for(int day = 0; day < modelData->nDays; day++)
+        /* the neighborhood of a customer is empty on days it is not available on */
+        for(int day : modelData->availableDays[u])
         {
             /* init with global neighborhood */
             for(int nb : modelData->neighbors[u][day])
             {
-                neighbors_[u][day].push_back(nb);
                 isForbidden_[u][nb] = false;
                 global_isForbidden_[u][nb] = false;
             }
             for(int pd: modelData->predecessors[u][day])
             {
-                predecessors_[u][day].push_back(pd);
                 isForbidden_[pd][u] = false;
                 global_isForbidden_[pd][u] = false;
             }
             /* init based on time windows */
-            if(modelData->timeWindows[u][day].end > 0)
-            {
-                timetable_[u][day] = TRUE;
-                global_timetable_[u][day] = TRUE;
-            }
+            timetable_[u][day] = TRUE;
+            global_timetable_[u][day] = TRUE;
         }
         isForbidden_[u][0] = false;
         global_isForbidden_[u][0] = false;
@@ -663,13 +885,22 @@ SCIP_DECL_PRICERINIT(ObjPricerVRP::scip_init)
     /* DSSR for ng-neighborhood */
     ng_DSSR_.resize(modelData->nC, bitset<neighborhood_size>());
 
-    /* Arc prices */
-    arcPrices_.resize(modelData->nC, vector<SCIP_Real>(modelData->nC));
+    /* Arc prices (only for the arcs of the global neighborhood) */
+    arcPrices_.resize(neighbors_.capacity());
+    returnPrices_.resize(modelData->nC);
+    fwArcs_.resize(modelData->nDays);
+    bwArcs_.resize(modelData->nDays);
+    dayGraphs_.resize(modelData->nDays);
 
     /* Day-Customer Assignment variables */
-    dayVarRedCosts_.resize(modelData->nC, vector<SCIP_Real>(modelData->nDays, SCIP_DEFAULT_INFINITY));
-    root_dayVarRedCosts_.resize(modelData->nC, vector<SCIP_Real>(modelData->nDays, 0.0));
-    root_dayVarLPObj_.resize(modelData->nC, vector<SCIP_Real>(modelData->nDays, -SCIP_DEFAULT_INFINITY));
+    /* stored for the available days only, the depot row covers all days */
+    vector<vector<int>> assignmentDays = modelData->availableDays;
+    assignmentDays[0].resize(modelData->nDays);
+    for(int day = 0; day < modelData->nDays; day++)
+        assignmentDays[0][day] = day;
+    dayVarRedCosts_.init(assignmentDays, SCIP_DEFAULT_INFINITY, SCIP_DEFAULT_INFINITY);
+    root_dayVarRedCosts_.init(assignmentDays, 0.0, 0.0);
+    root_dayVarLPObj_.init(assignmentDays, -SCIP_DEFAULT_INFINITY, -SCIP_DEFAULT_INFINITY);
     arcRedCosts_.resize(modelData->nC, vector<SCIP_Real>(modelData->nC, SCIP_DEFAULT_INFINITY));
     root_arcRedCosts_.resize(modelData->nC, vector<SCIP_Real>(modelData->nC, 0.0));
     root_arcLPObj_.resize(modelData->nC, vector<SCIP_Real>(modelData->nC, -SCIP_DEFAULT_INFINITY));
@@ -698,6 +929,18 @@ SCIP_DECL_PRICERINIT(ObjPricerVRP::scip_init)
 
     // TODO: we do not need it in pricerdata, do we?
     dualValues_.resize(modelData->nC + modelData->nDays);
+    subgradient_.resize(modelData->nC + modelData->nDays);
+    dayMinRedCosts_.resize(modelData->nDays);
+    labelStage_.resize(modelData->nDays, 0);
+
+    /* additional dual vectors for labeling */
+    nAltDuals_ = 0;
+    if(nDualVectors_ > 1)
+    {
+        altDualValues_.resize(nDualVectors_ - 1, vector<SCIP_Real>(modelData->nC + modelData->nDays));
+        altArcPrices_.resize(nDualVectors_ - 1, vector<SCIP_Real>(neighbors_.capacity()));
+        minArcPrices_.resize(neighbors_.capacity());
+    }
 
     /* constraint handler */
     cons_arcflow_ = SCIPfindConshdlr(scip, "arcflow");
@@ -717,6 +960,7 @@ SCIP_DECL_PRICERINIT(ObjPricerVRP::scip_init)
     nnonzSRC_ = 0;
 
     atRoot_ = true;
+    isDiving_ = false;
 
     dayisone_.resize(modelData->nDays, false);
     nodeisone_.resize(modelData->nDays, 0);
@@ -728,7 +972,9 @@ SCIP_DECL_PRICERINIT(ObjPricerVRP::scip_init)
 /** perform pricing */
 SCIP_RETCODE ObjPricerVRP::pricing(
     SCIP*                 scip,               /**< SCIP data structure */
-    bool                  isFarkas            /**< whether we perform Farkas pricing */
+    bool                  isFarkas,           /**< whether we perform Farkas pricing */
+    SCIP_Real*            lowerbound,         /**< pointer to store the Lagrangian bound, or nullptr */
+    SCIP_Bool*            stopearly           /**< pointer to store whether column generation can stop, or nullptr */
     )
 {
     int nvars;
@@ -736,7 +982,7 @@ SCIP_RETCODE ObjPricerVRP::pricing(
     auto* probData = dynamic_cast<vrp::ProbDataVRP*>(SCIPgetObjProbData(scip_));
     long long int currNode = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
 
-    if(SCIPinProbing(scip))
+    if(SCIPinProbing(scip) && !isDiving_)
     {
         if(SCIPisLT(scip, SCIPgetLPObjval(scip), prop_tourfixing_->obj_cmp_))
         {
@@ -760,6 +1006,9 @@ SCIP_RETCODE ObjPricerVRP::pricing(
 
         tree_data_[currNode] = node_data();
 
+        /* the stability center of the parent is no longer valid */
+        centerDuals_.clear();
+
         if(sepfirst)
         {
             if(SCIPisLE(scip, SCIPgetLPObjval(scip), SCIPgetPrimalbound(scip)))
@@ -769,9 +1018,22 @@ SCIP_RETCODE ObjPricerVRP::pricing(
         }
     }
 
-    /* check for primal heuristic solution to add */
-    bool success = false;
-    SCIP_CALL( checkPrimalHeuristic(scip, probData, &success));
+    /* the columns of the primal heuristics are not added during the dive, the probing LP only gets priced columns */
+    if(!isDiving_)
+    {
+        /* check for primal heuristic solution to add */
+        bool success = false;
+        SCIP_CALL( checkPrimalHeuristic(scip, probData, &success));
+
+        /* repair new best solutions of the set covering master */
+        SCIP_CALL( repairPrimalSolution(scip, probData, this));
+
+        /* exchange solutions with the background ALNS */
+        SCIP_CALL( checkALNSHeuristic(scip, probData));
+
+        /* add the solution of the restricted master heuristic */
+        SCIP_CALL( checkRestrictedMasterHeuristic(scip, probData));
+    }
 
     if(tree_data_[currNode].gotFixed)
     {
@@ -791,6 +1053,9 @@ SCIP_RETCODE ObjPricerVRP::pricing(
     /* set arc prices */
     SCIP_CALL(setArcPrices(probData->getData(), isFarkas));
 
+    /* set additional dual vectors */
+    SCIP_CALL(setAltDualVectors(scip, probData->getData(), isFarkas));
+
     /* check for subset row cuts */
     if(SCIPconshdlrGetNConss(cons_src_) > 0)
     {
@@ -806,6 +1071,15 @@ SCIP_RETCODE ObjPricerVRP::pricing(
     }
 
     /** START PRICING */
+    /* Farkas pricing without labeling */
+    if(isFarkas && useFarkasCovering_)
+    {
+        SCIP_Bool success;
+        SCIP_CALL( farkas_pricing(scip, probData, &success) );
+        if(success)
+            return SCIP_OKAY;
+    }
+
     /* Heuristic local search pricing */
     nvars = probData->nVars_;
     if(SCIPconshdlrGetNConss(cons_src_) == 0 && probData->prop_success_ == 0)
@@ -815,9 +1089,50 @@ SCIP_RETCODE ObjPricerVRP::pricing(
             return SCIP_OKAY;
     }
 
-    /* Exact pricing */
+    /* Pricing with smoothed duals, the exact pricing below always runs on the LP duals */
+    nvars = probData->nVars_;
+    bool smoothing = useSmoothing_ && !isFarkas && !SCIPinProbing(scip);
+    if(smoothing && !centerDuals_.empty())
+    {
+        SCIP_CALL( smoothed_pricing(scip, probData));
+        if(nvars != probData->nVars_)
+            return SCIP_OKAY;
+    }
+
+    /* Heuristic labeling with a label budget, it is exact if the budget was not exceeded on any day */
     nvars = probData->nVars_;
-    SCIP_CALL( generate_tours(scip, probData, isFarkas, getDayVarRed, false));
+    bool isExact = false;
+    if(heurMaxLabels_ >= 0)
+    {
+        SCIP_CALL( generate_tours(scip, probData, isFarkas, getDayVarRed, true));
+        isExact = none_of(labelStage_.begin(), labelStage_.end(), [](int stage){ return stage > 0; });
+        if(!isExact && nvars != probData->nVars_)
+            return SCIP_OKAY;
+    }
+
+    /* Exact pricing */
+    if(!isExact)
+        SCIP_CALL( generate_tours(scip, probData, isFarkas, getDayVarRed, false));
+    if(smoothing)
+        centerDuals_ = dualValues_;
+
+    /* stop column generation if the Lagrangian bound proves the cutoff of the node or if it tails off, the root always
+     * prices to the end, so that the reduced cost fixing works on the final duals */
+    if(lowerbound != nullptr && !SCIPinProbing(scip) && nvars != probData->nVars_)
+    {
+        assert(!isFarkas && stopearly != nullptr);
+        SCIP_Real bound = getLagrangianBound(scip, probData->getData());
+        if(!SCIPisInfinity(scip, -bound))
+        {
+            SCIP_Real lpobj = SCIPgetLPObjval(scip);
+            *lowerbound = bound;
+            if(currNode != 1 && (SCIPisGE(scip, bound, SCIPgetCutoffbound(scip)) ||
+                    (SCIPisPositive(scip, earlyBranchingGap_) && lpobj - bound <= earlyBranchingGap_ * fabs(lpobj))))
+                *stopearly = TRUE;
+            if(*stopearly)
+                probData->nonzeroVars_.clear();
+        }
+    }
 
     /* save ng_dssr_data for finished branching node */
     if(nvars == probData->nVars_)
@@ -841,6 +1156,7 @@ SCIP_RETCODE ObjPricerVRP::pricing(
                     varfixing_gap_ = local_gap;
 
                     getDayVarRed = true;
+                    nAltDuals_ = 0;
                     SCIP_CALL( generate_tours(scip, probData, isFarkas, getDayVarRed, false));
 
                     prop_varfixing_->active_redcosts_ = true;
@@ -867,7 +1183,7 @@ SCIP_DECL_PRICERREDCOST(ObjPricerVRP::scip_redcost)
    *result = SCIP_SUCCESS;
 
    /* call pricing routine */
-   SCIP_CALL( pricing(scip, false) );
+   SCIP_CALL( pricing(scip, false, lowerbound, stopearly) );
 
    return SCIP_OKAY;
 } /*lint !e715*/
@@ -882,7 +1198,7 @@ SCIP_DECL_PRICERFARKAS(ObjPricerVRP::scip_farkas)
     *result = SCIP_SUCCESS;
 
    /* call pricing routine */
-   SCIP_CALL( pricing(scip, true) );
+   SCIP_CALL( pricing(scip, true, nullptr, nullptr) );
 
    return SCIP_OKAY;
 } /*lint !e715*/
@@ -939,20 +1255,125 @@ SCIP_RETCODE ObjPricerVRP::setArcPrices(
         model_data*         modelData,
         bool                isFarkas
 ){
-    /* initialize for new dualvalues and isFarkas-state */
-    for(int i = 0; i < modelData->nC; i++)
+    double travelFactor = isFarkas ? 0.0 : 1.0;
+    const SCIP_Real* duals = dualValues_.data();
+
+    /* the depot has no dual value */
+    for(int u = 1; u < modelData->nC; u++)
+        returnPrices_[u] = travelFactor * modelData->travel[u][0];
+
+    /* initialize for new dualvalues and isFarkas-state, only the arcs of the current neighborhood are priced */
+    for(int day = 0; day < modelData->nDays; day++)
     {
-        for(int j = i+1; j < modelData->nC; j++)
+        for(int u = 0; u < modelData->nC; u++)
         {
-            arcPrices_[i][j] = (!isFarkas)*modelData->travel[i][j] - dualValues_[j];
-            arcPrices_[j][i] = (!isFarkas)*modelData->travel[j][i] - dualValues_[i];
+            day_adjacency::list_ref heads = neighbors_[u][day];
+            const int* head = heads.begin();
+            int nArcs = heads.size();
+            SCIP_Real* prices = arcPrices_.data() + neighbors_.offset(u, day);
+            auto travel = modelData->travel[u];
+            /* gather the travel times and duals of the heads */
+            for(int a = 0; a < nArcs; a++)
+                prices[a] = travelFactor * travel[head[a]] - duals[head[a]];
+            /* each enforced customer of the day gives its prize on its ingoing arcs */
+            if(nEC_[day] > 0 && !isFarkas)
+            {
+                for(int a = 0; a < nArcs; a++)
+                {
+                    if(eC_[head[a]] == day)
+                        prices[a] -= ENFORCED_PRICE_COLLECTING;
+                }
+            }
         }
+        /* constant part of the reduced costs of a route of the day, paid when leaving the depot */
+        SCIP_Real routePrice = -duals[modelData->nC + day] - dual_nVehicle_;
+        if(!isFarkas)
+            routePrice += nEC_[day] * ENFORCED_PRICE_COLLECTING;
+        if(!modelData->minTravel && !isFarkas)
+            routePrice += 1;
+        SCIP_Real* prices = arcPrices_.data() + neighbors_.offset(0, day);
+        for(int a = 0; a < neighbors_[0][day].size(); a++)
+            prices[a] += routePrice;
     }
     /* if there are robust cuts, include their dual information */
     if(SCIPconshdlrGetNConss(cons_kpc_) > 0)
     {
         SCIP_CALL(includeCuts(this, modelData, isFarkas));
     }
+    /* the scale of the Farkas duals is arbitrary, next to the big-M prize they would be lost in rounding errors */
+    if(isFarkas)
+        setFarkasEnforcedPrizes(this, modelData);
+    return SCIP_OKAY;
+}
+
+/** sets the additional dual vectors and their arc prices for current pricing iteration
+ *
+ *  The additional vectors are convex combinations of the current duals and the duals of the last redcost pricing
+ *  iteration. The labeling shares all resources between the vectors and only keeps one reduced cost value per vector.
+ *  SRC and KPC duals are not combined, their influence is the same for all vectors.
+ */
+SCIP_RETCODE ObjPricerVRP::setAltDualVectors(
+        SCIP*               scip,
+        model_data*         modelData,
+        bool                isFarkas
+){
+    int nDuals = modelData->nC + modelData->nDays;
+    /* the vectors are allocated at the start of the solve */
+    int nVectors = (int) altDualValues_.size() + 1;
+    int i, j, k;
+
+    nAltDuals_ = 0;
+    if(nVectors <= 1 || isFarkas || SCIPinProbing(scip))
+        return SCIP_OKAY;
+
+    /* the duals of the last iteration have to differ from the current ones */
+    bool changed = false;
+    if(!lastDualValues_.empty())
+    {
+        for(i = 1; i < nDuals; i++)
+        {
+            if(!SCIPisEQ(scip, dualValues_[i], lastDualValues_[i]))
+            {
+                changed = true;
+                break;
+            }
+        }
+    }
+    if(changed)
+    {
+        nAltDuals_ = nVectors - 1;
+        minArcPrices_ = arcPrices_;
+        for(k = 0; k < nAltDuals_; k++)
+        {
+            double alpha = (double) (k + 1) / nVectors;
+            vector<SCIP_Real>& altDuals = altDualValues_[k];
+            for(i = 0; i < nDuals; i++)
+            {
+                altDuals[i] = (1 - alpha) * dualValues_[i] + alpha * lastDualValues_[i];
+            }
+            /* arc prices only differ in the dual value of the head (and of the day when leaving the depot),
+             * the arcs back to the depot have the same price for all vectors */
+            for(int day = 0; day < modelData->nDays; day++)
+            {
+                for(i = 0; i < modelData->nC; i++)
+                {
+                    day_adjacency::list_ref heads = neighbors_[i][day];
+                    int offset = neighbors_.offset(i, day);
+                    SCIP_Real shift = i == 0 ? dualValues_[modelData->nC + day] - altDuals[modelData->nC + day] : 0.0;
+                    for(int a = 0; a < heads.size(); a++)
+                    {
+                        j = heads[a];
+                        SCIP_Real price = arcPrices_[offset + a] + dualValues_[j] - altDuals[j] + shift;
+                        altArcPrices_[k][offset + a] = price;
+                        if(price < minArcPrices_[offset + a])
+                            minArcPrices_[offset + a] = price;
+                    }
+                }
+            }
+        }
+    }
+    lastDualValues_ = dualValues_;
+
     return SCIP_OKAY;
 }
 
@@ -994,13 +1415,29 @@ SCIP_RETCODE ObjPricerVRP::includeSRCpricingData(
     return SCIP_OKAY;
 }
 
+SCIP_Real ObjPricerVRP::getArcPrice(
+        int             u,
+        int             v,
+        int             day
+){
+    if(v == 0)
+        return returnPrices_[u];
+    day_adjacency::list_ref heads = neighbors_[u][day];
+    for(int a = 0; a < heads.size(); a++)
+    {
+        if(heads[a] == v)
+            return arcPrices_[neighbors_.offset(u, day) + a];
+    }
+    return SCIP_DEFAULT_INFINITY;
+}
+
 SCIP_Real ObjPricerVRP::getTourVRPredcosts(
-        model_data*     modelData,
         tourVRP&        tvrp
 ){
     int day = tvrp.getDay();
     SCIP_Real srcVal;
-    SCIP_Real redcosts = -dualValues_[modelData->nC + day] - dual_nVehicle_;
+    /* the duals of the day and the vehicles are part of the price of the first arc */
+    SCIP_Real redcosts = 0.0;
 
     for(int c = 0; c < nnonzSRC_; c++)
     {
@@ -1016,16 +1453,130 @@ SCIP_Real ObjPricerVRP::getTourVRPredcosts(
     }
 
     vector<int>& tour = tvrp.tour_;
-    redcosts += arcPrices_[0][tour[0]];
+    redcosts += getArcPrice(0, tour[0], day);
     for(int i = 1; i < tvrp.length_; i++)
     {
-        redcosts += arcPrices_[tour[i-1]][tour[i]];
+        redcosts += getArcPrice(tour[i-1], tour[i], day);
     }
-    redcosts += arcPrices_[tour[tvrp.length_-1]][0];
+    redcosts += getArcPrice(tour[tvrp.length_-1], 0, day);
+
+    return redcosts;
+}
+
+SCIP_Real ObjPricerVRP::getLagrangianBound(
+        SCIP*               scip,
+        model_data*         modelData
+){
+    SCIP_Real bound = SCIPgetLPObjval(scip);
+    for(int day = 0; day < modelData->nDays; day++)
+    {
+        /* no routes are priced for fixed days */
+        if(fixedDay_[day])
+            continue;
+        if(SCIPisInfinity(scip, -dayMinRedCosts_[day]))
+            return -SCIPinfinity(scip);
+        bound += modelData->num_v[day] * min(0.0, dayMinRedCosts_[day]);
+    }
+    return bound;
+}
+
+SCIP_Real ObjPricerVRP::getLPRedCosts(
+        model_data*     modelData,
+        tourVRP&        tvrp,
+        SCIP_Real       redcosts
+){
+    /* the tour pays the duals of its customers and of its day */
+    int day = modelData->nC + tvrp.getDay();
+    redcosts += dualValues_[day] - lpDualValues_[day];
+    for(auto u : tvrp.tour_)
+        redcosts += dualValues_[u] - lpDualValues_[u];
 
     return redcosts;
 }
 
+void ObjPricerVRP::setSubgradient(
+        model_data*                 modelData,
+        vector<vector<tourVRP>>&    tours,
+        vector<vector<double>>&     redCosts
+){
+    /* the customers are covered once and each day has its vehicles, the best tour of a day is used by all of them */
+    subgradient_[0] = 0.0;
+    for(int u = 1; u < modelData->nC; u++)
+        subgradient_[u] = 1.0;
+    for(int day = 0; day < modelData->nDays; day++)
+    {
+        subgradient_[modelData->nC + day] = modelData->num_v[day];
+        if(fixedDay_[day] || tours[day].empty())
+            continue;
+        int best = (int) (min_element(redCosts[day].begin(), redCosts[day].end()) - redCosts[day].begin());
+        subgradient_[modelData->nC + day] = 0.0;
+        for(auto u : tours[day][best].tour_)
+            subgradient_[u] -= modelData->num_v[day];
+    }
+}
+
+/** generates tours with the duals smoothed towards the stability center (Wentges smoothing with the center of Neame)
+ *
+ *  The smoothed duals are alpha * center + (1 - alpha) * LP duals. Only tours with negative reduced costs w.r.t. the LP
+ *  duals are added. If there are none (mis-pricing), alpha is decreased to 1 - k * (1 - smoothingFactor_) in the k-th
+ *  try, until it reaches zero or smoothingMaxTries_ labelings were done and the exact pricing on the LP duals takes
+ *  over. After a successful round the smoothing factor is adapted by the direction of the subgradient at the smoothed
+ *  duals.
+ */
+SCIP_RETCODE ObjPricerVRP::smoothed_pricing(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData
+){
+    model_data* modelData = probData->getData();
+    int nDuals = modelData->nC + modelData->nDays;
+    int nvars = probData->nVars_;
+    int nAltDuals = nAltDuals_;
+    int i;
+
+    lpDualValues_ = dualValues_;
+    /* additional dual vectors are only combined with the LP duals */
+    nAltDuals_ = 0;
+    isSmoothed_ = true;
+    for(int k = 1; k <= smoothingMaxTries_ && nvars == probData->nVars_; k++)
+    {
+        SCIP_Real alpha = 1.0 - k * (1.0 - smoothingFactor_);
+        if(!SCIPisPositive(scip, alpha))
+            break;
+        bool differs = false;
+        for(i = 0; i < nDuals; i++)
+        {
+            dualValues_[i] = alpha * centerDuals_[i] + (1.0 - alpha) * lpDualValues_[i];
+            if(!SCIPisEQ(scip, dualValues_[i], lpDualValues_[i]))
+                differs = true;
+        }
+        if(!differs)
+            break;
+        SCIP_CALL(setArcPrices(modelData, false));
+        SCIP_CALL(generate_tours(scip, probData, false, false, false));
+    }
+    isSmoothed_ = false;
+
+    if(nvars != probData->nVars_)
+    {
+        /* the LP duals lie in an ascent direction: smooth less, otherwise more; the factor stays positive, since
+         * a factor of zero would stop the smoothing for the rest of the solve */
+        SCIP_Real direction = 0.0;
+        for(i = 0; i < nDuals; i++)
+            direction += subgradient_[i] * (lpDualValues_[i] - dualValues_[i]);
+        if(direction > 0)
+            smoothingFactor_ = max(0.1, smoothingFactor_ - 0.1);
+        else
+            smoothingFactor_ = min(0.99, smoothingFactor_ + 0.1 * (1.0 - smoothingFactor_));
+        centerDuals_ = dualValues_;
+    }
+    /* restore the LP duals */
+    dualValues_ = lpDualValues_;
+    nAltDuals_ = nAltDuals;
+    SCIP_CALL(setArcPrices(modelData, false));
+
+    return SCIP_OKAY;
+}
+
 /** generates negative reduced cost tours (uses restricted shortest path dynamic programming algorithm) */
 SCIP_RETCODE ObjPricerVRP::generate_tours(
     SCIP*                   scip,
@@ -1035,68 +1586,24 @@ SCIP_RETCODE ObjPricerVRP::generate_tours(
     bool                    isHeuristic
 )
 {
-    char algoName[] = "pricingLabel"; // TODO: Check for Probing Variables!
-
+    /* fixed days are not labeled */
+    labelStage_.assign(labelStage_.size(), 0);
     if(!PARALLEL_LABELING)
     {
+        vector<vector<tourVRP>> tours(probData->getData()->nDays, vector<tourVRP>());
+        vector<vector<double>> redCosts(probData->getData()->nDays, vector<double>());
         for(int i = 0; i < probData->getData()->nDays; i++)
         {
             if(fixedDay_[i])
                 continue;
-            vector<tourVRP> bestTours;
- 
-            if(SCIPinProbing(scip) && i == prop_tourfixing_->tvrp_.getDay() && prop_tourfixing_->up_)
-                SCIP_CALL(generateLabelsBiDir(scip, probData->getData(), this, bestTours, isFarkas, getDayVarRed, false, true, i));
-            else
-                SCIP_CALL(generateLabelsBiDir(scip, probData->getData(), this, bestTours, isFarkas, getDayVarRed, false, false, i));
-
-
-            int count = 0;
-
-            for(auto& tvrp : bestTours)
-            {
-                if(SCIPinProbing(scip) && prop_tourfixing_->up_)
-                {
-                    if(i == prop_tourfixing_->tvrp_.getDay() && SCIPisEQ(scip, prop_tourfixing_->tvrp_.obj_, tvrp.obj_)
-                    && prop_tourfixing_->tvrp_.length_ == tvrp.length_)
-                    {
-                        bool isfixtour = true;
-                        for(int j = 0; j < tvrp.length_; j++)
-                        {
-                            if(tvrp.tour_[j] != prop_tourfixing_->tvrp_.tour_[j])
-                            {
-                                isfixtour = false;
-                                break;
-                            }
-                        }
-                        if(isfixtour)
-                        {
-                            continue;
-                        }
-                    }
-                }
-                if(getDayVarRed)
-                {
-                    model_data *modelData = probData->getData();
-                    assert(tvrp.isFeasible(modelData));
-                    assert(false);
-                }
-                /* check for ng-path violations */
-                if(USE_DSSR)
-                {
-                    if(violatesNGProperty(probData->getData()->ng_set, ng_DSSR_, tvrp.tour_))
-                        continue;
-                }
-                assert(tvrp.length_ > 0);
-                SCIP_CALL(add_tour_variable(scip, probData, isFarkas, FALSE, algoName, tvrp));
 
-                count++;
-                if(count > probData->getData()->nC / 4) // TODO: what is a good criteria?
-                {
-                    break;
-                }
-            }
+            /* the probed tour must not be generated again */
+            tourVRP* excludedTour = getExcludedTour(scip);
+            bool excludeTour = excludedTour != nullptr && i == excludedTour->getDay();
+            SCIP_CALL(generateLabelsBiDir(scip, probData->getData(), this, tours[i], redCosts[i], getDayVarRed,
+                                          isHeuristic, excludeTour, i));
         }
+        SCIP_CALL(addSelectedTours(scip, probData, this, tours, redCosts, isFarkas));
     }else
     {
         SCIP_CALL( labelingAlgorithmnParallel(scip, probData, this, isFarkas, isHeuristic, getDayVarRed) );
@@ -1104,6 +1611,107 @@ SCIP_RETCODE ObjPricerVRP::generate_tours(
     return SCIP_OKAY;
 }
 
+/** Farkas pricing without labeling
+ *
+ *  Infeasible restricted masters after branching often need several Farkas rounds. A pooled column with negative Farkas
+ *  coefficient enters the LP anyway, since SCIP prices the variables outside of the LP before calling the pricers. The
+ *  coefficient is taken from the column itself, since the arc prices contain the artificial prize of the enforced
+ *  customers. Otherwise, the customers that cannot be covered are dispatched into new routes by farkasCoveringPricing().
+ *  Sets success to TRUE if a pooled column enters the LP or if columns were added, such that the labeling can be skipped
+ *  in this round.
+ */
+SCIP_RETCODE ObjPricerVRP::farkas_pricing(
+        SCIP*                       scip,
+        vrp::ProbDataVRP*           probData,
+        SCIP_Bool*                  success
+){
+    *success = FALSE;
+    if(SCIPhasPooledColumns(scip, probData))
+    {
+        for(auto* var : probData->vars_)
+        {
+            if(SCIPvarIsInLP(var) || SCIPvarGetStatus(var) != SCIP_VARSTATUS_COLUMN || SCIPvarGetUbLocal(var) < 0.5)
+                continue;
+            /* the pooled column enters the LP, the labeling waits for the next Farkas round */
+            if(SCIPisNegative(scip, SCIPgetColFarkasCoef(scip, SCIPvarGetCol(var))))
+            {
+                *success = TRUE;
+                return SCIP_OKAY;
+            }
+        }
+    }
+
+    int nvars = probData->nVars_;
+    SCIP_CALL( farkasCoveringPricing(scip, this, probData, dualValues_) );
+    *success = nvars != probData->nVars_;
+
+    return SCIP_OKAY;
+}
+
+/** tour that must not be generated again while probing: the tour probed by the tour variable fixing or the tour rejected
+ *  by a backtrack of the price-and-dive heuristic */
+tourVRP* ObjPricerVRP::getExcludedTour(
+        SCIP*                       scip
+){
+    if(!SCIPinProbing(scip))
+        return nullptr;
+    if(isDiving_)
+        return diveExcludedTour_.length_ > 0 ? &diveExcludedTour_ : nullptr;
+    return &prop_tourfixing_->tvrp_;
+}
+
+/** saves the pricing graph of the current node before the price-and-dive heuristic starts probing
+ *
+ *  At the root the labeling works on the global timetable only, during the dive it uses timetable_, which is set to the
+ *  timetable of the node combined with the global one.
+ */
+SCIP_RETCODE ObjPricerVRP::startDive()
+{
+    assert(!isDiving_);
+
+    diveTimetable_ = timetable_;
+    diveEC_ = eC_;
+    diveNEC_ = nEC_;
+    diveAtRoot_ = atRoot_;
+    diveExcludedTour_ = tourVRP();
+
+    isDiving_ = true;
+    atRoot_ = false;
+    timetable_.assignAnd(diveTimetable_, global_timetable_);
+
+    return SCIP_OKAY;
+}
+
+/** restricts the pricing of the dive to the given timetable */
+SCIP_RETCODE ObjPricerVRP::setDiveTimetable(
+        model_data*                 modelData,
+        const bit_matrix&           timetable
+){
+    assert(isDiving_);
+
+    timetable_ = timetable;
+    SCIP_CALL( setEnforcedCustomers(this, modelData) );
+    SCIP_CALL( setCurrentNeighborhood(this, modelData, false) );
+
+    return SCIP_OKAY;
+}
+
+/** restores the pricing graph of the current node after the dive */
+SCIP_RETCODE ObjPricerVRP::endDive(
+        model_data*                 modelData
+){
+    assert(isDiving_);
+
+    timetable_ = diveTimetable_;
+    eC_ = diveEC_;
+    nEC_ = diveNEC_;
+    atRoot_ = diveAtRoot_;
+    isDiving_ = false;
+    SCIP_CALL( setCurrentNeighborhood(this, modelData, atRoot_) );
+
+    return SCIP_OKAY;
+}
+
 /** generates negative reduced cost tour (uses local search heuristics) */
 bool ObjPricerVRP::heuristic_pricing(
         SCIP*                       scip,
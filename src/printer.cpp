@@ -3,7 +3,7 @@
 
 SCIP_RETCODE printTimetable(
         model_data*             modelData,
-        vector<vector<bool>>&   timetable
+        bit_matrix&             timetable
 ){
     cout << "days: ";
     for(int d = 0; d < modelData->nDays; d++)
@@ -119,6 +119,7 @@ SCIP_RETCODE ProbDataVRP::scip_trans(
     {
         SCIP_CALL( SCIPgetTransformedVar(scip, vars_[i], &(transprobdatavrp->vars_[i])) );
     }
+    transprobdatavrp->columnIndex_ = columnIndex_;
     // save data pointer
     assert( objprobdata != nullptr );
     *objprobdata = transprobdatavrp;
@@ -205,7 +206,7 @@ SCIP_RETCODE SCIPprobdataCreate(
     if(!modeldata->minTravel)
         SCIP_CALL( SCIPsetObjIntegral(scip) );
 
-    /* create set partitioning constraints for each customer but the depot */
+    /* create set partitioning (or covering) constraints for each customer but the depot */
     assert(modeldata->nC > 1);
     for( i = 0; i < modeldata->nC - 1; ++i )
     {
@@ -216,7 +217,8 @@ SCIP_RETCODE SCIPprobdataCreate(
         //SCIP_CALL( SCIPcreateConsBasicSetcover(scip, &con, name, 0, NULL) );
 
 //        SCIP_CALL( SCIPcreateConsBasicSetpart(scip, &con, name, 0, nullptr) );
-        SCIP_CALL(SCIPcreateConsBasicLinear(scip, &con, name, 0, nullptr, nullptr, 1.0, 1.0));
+        SCIP_CALL(SCIPcreateConsBasicLinear(scip, &con, name, 0, nullptr, nullptr, 1.0,
+                                            modeldata->setCovering ? SCIPinfinity(scip) : 1.0));
 
         /* declare constraint modifiable for adding variables during pricing */
         SCIP_CALL( SCIPsetConsModifiable(scip, con, TRUE) );
@@ -263,6 +265,104 @@ SCIP_RETCODE SCIPprobdataCreate(
     return SCIP_OKAY;
 }
 
+const int* column_store::add(
+    const int*      tour,
+    int             length
+){
+    /* sequences longer than a block get a block of their own */
+    if(blocks_.empty() || used_ + length > BLOCK_SIZE)
+    {
+        blocks_.emplace_back(new int[max(length, BLOCK_SIZE)]);
+        used_ = 0;
+    }
+    int* first = blocks_.back().get() + used_;
+    std::copy(tour, tour + length, first);
+    used_ += length;
+    return first;
+}
+
+void column_index::init(
+    int             nC,
+    int             nDays
+){
+    nC_ = nC;
+    byArc_.clear();
+    byCustomerDay_.clear();
+    byCustomer_.assign(nC, vector<int>());
+    byDay_.assign(nDays, vector<int>());
+}
+
+/** appends col to a list unless it is already its last entry (customers visited twice) */
+static
+void addToList(
+    vector<int>&    list,
+    int             col
+){
+    if(list.empty() || list.back() != col)
+        list.push_back(col);
+}
+
+void column_index::add(
+    int             col,
+    int             day,
+    const int*      tour,
+    int             length
+){
+    if(length == 0)
+        return;
+    byDay_[day].push_back(col);
+    addToList(byArc_[tour[0]], col);
+    for(int i = 0; i < length; i++)
+    {
+        int u = tour[i];
+        int v = i + 1 < length ? tour[i + 1] : 0;
+        addToList(byArc_[(long long) u * nC_ + v], col);
+        addToList(byCustomerDay_[(long long) day * nC_ + u], col);
+        addToList(byCustomer_[u], col);
+    }
+}
+
+const vector<int>& column_index::getArc(
+    int             u,
+    int             v
+) const
+{
+    auto it = byArc_.find((long long) u * nC_ + v);
+    return it != byArc_.end() ? it->second : empty_;
+}
+
+const vector<int>& column_index::getCustomerDay(
+    int             u,
+    int             day
+) const
+{
+    auto it = byCustomerDay_.find((long long) day * nC_ + u);
+    return it != byCustomerDay_.end() ? it->second : empty_;
+}
+
+void column_index::getConflicts(
+    const bit_matrix&   isForbidden,
+    const bit_matrix&   timetable,
+    int                 first,
+    vector<int>&        cols
+) const
+{
+    for(auto& entry : byArc_)
+    {
+        if(!isForbidden[(int) (entry.first / nC_)][(int) (entry.first % nC_)])
+            continue;
+        auto it = lower_bound(entry.second.begin(), entry.second.end(), first);
+        cols.insert(cols.end(), it, entry.second.end());
+    }
+    for(auto& entry : byCustomerDay_)
+    {
+        if(timetable[(int) (entry.first % nC_)][(int) (entry.first / nC_)])
+            continue;
+        auto it = lower_bound(entry.second.begin(), entry.second.end(), first);
+        cols.insert(cols.end(), it, entry.second.end());
+    }
+}
+
 /** adds given variable to the problem data */
 SCIP_RETCODE SCIPprobdataAddVar(
         SCIP*                   scip,                   /**< SCIP data structure */
@@ -273,11 +373,12 @@ SCIP_RETCODE SCIPprobdataAddVar(
     /* caputure variables */
     SCIP_CALL( SCIPcaptureVar(scip, var) );
     auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
-    if(vardata->tourVrp_.length_ == 0)
+    if(vardata->getLength() == 0)
     {
         objprobdata->emptyVars_.push_back(var);
     }else
     {
+        objprobdata->columnIndex_.add(objprobdata->nVars_, vardata->getDay(), vardata->tour_, vardata->getLength());
         objprobdata->nVars_++;
         objprobdata->vars_.push_back(var);
     }
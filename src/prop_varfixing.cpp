@@ -30,8 +30,8 @@ SCIP_RETCODE updateRootRedCosts(
             /* update if current improves the best red costs */
             if(SCIPisGT(scip, current_redcosts + current_objval, best_redcosts + best_objval))
             {
-                pricerData->root_dayVarRedCosts_[cust][day] = current_redcosts;
-                pricerData->root_dayVarLPObj_[cust][day] = current_objval;
+                pricerData->root_dayVarRedCosts_.at(cust, day) = current_redcosts;
+                pricerData->root_dayVarLPObj_.at(cust, day) = current_objval;
             }
         }
     }
@@ -162,57 +162,40 @@ SCIP_RETCODE tourVarFixing(
     ObjPricerVRP*       pricerData,
     bool                isGlobal
 ){
-    vector<vector<bool>>& timetable = isGlobal ?  pricerData->global_timetable_ : pricerData->timetable_;
-    vector<vector<bool>>& isForbidden = isGlobal ? pricerData->global_isForbidden_ : pricerData->isForbidden_;
+    bit_matrix& timetable = isGlobal ?  pricerData->global_timetable_ : pricerData->timetable_;
+    bit_matrix& isForbidden = isGlobal ? pricerData->global_isForbidden_ : pricerData->isForbidden_;
 
     pricerData->fixed_nonzero_ = false;
     SCIP_Bool fixed;
     SCIP_Bool infeasible;
     int cnt = 0;
-    for (auto var: probData->vars_) {
-        fixed = false;
+    /* columns with a forbidden arc or a customer that is not available on the day of the column */
+    vector<int> conflicts;
+    probData->columnIndex_.getConflicts(isForbidden, timetable, 0, conflicts);
+    for (int col: conflicts) {
+        SCIP_VAR* var = probData->vars_[col];
+        /* also skips columns collected more than once */
         if (!isGlobal && SCIPvarGetUbLocal(var) < 0.5)
             continue;
         if(isGlobal && SCIPvarGetUbGlobal(var) < 0.5)
             continue;
-
-        auto *varData = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
-        tourVRP &tvrp = varData->tourVrp_;
-
-        int day = tvrp.getDay();
-        /* check first/last arc and first customer */
-        if (isForbidden[tvrp.tour_[tvrp.length_ - 1]][0] ||
-                isForbidden[0][tvrp.tour_[0]] || !timetable[tvrp.tour_[0]][day]) {
-            fixed = TRUE;
-        } else {
-            /* check inner arcs and rest of customers */
-            for (int v = 1; v < tvrp.length_; v++) {
-                if (!timetable[tvrp.tour_[v]][day] ||
-                    isForbidden[tvrp.tour_[v - 1]][tvrp.tour_[v]]) {
-                    fixed = TRUE;
-                    break;
-                }
-            }
+        cnt++;
+        if(!SCIPisZero(scip, SCIPvarGetLPSol(var)))
+        {
+//            cout << "var with val: " << SCIPvarGetLPSol(var) << endl;
+//            SCIPprintVar(scip, var , nullptr);
+            pricerData->fixed_nonzero_ = true;
         }
-        if (fixed) {
-            cnt++;
-            if(!SCIPisZero(scip, SCIPvarGetLPSol(var)))
-            {
-//                cout << "var with val: " << SCIPvarGetLPSol(var) << endl;
-//                SCIPprintVar(scip, var , nullptr);
-                pricerData->fixed_nonzero_ = true;
-            }
-//                assert(SCIPisZero(scip, SCIPvarGetLPSol(var))); // TODO check if only due to EC
-            if(isGlobal)
-            {
-                SCIP_CALL(SCIPtightenVarUbGlobal(scip, var, 0, TRUE, &infeasible, &fixed));
-            }else
-            {
-                SCIP_CALL(SCIPfixVar(scip, var, 0.0, &infeasible, &fixed));
-            }
-            assert(!infeasible); // TODO - 60_0.25
-            assert(fixed);
+//            assert(SCIPisZero(scip, SCIPvarGetLPSol(var))); // TODO check if only due to EC
+        if(isGlobal)
+        {
+            SCIP_CALL(SCIPtightenVarUbGlobal(scip, var, 0, TRUE, &infeasible, &fixed));
+        }else
+        {
+            SCIP_CALL(SCIPfixVar(scip, var, 0.0, &infeasible, &fixed));
         }
+        assert(!infeasible); // TODO - 60_0.25
+        assert(fixed);
     }
 //    cout << "FIXED " << cnt << " TOUR VARIABLES!!" << endl;
 
@@ -7,33 +7,78 @@
 #include "probdata_vrp.h"
 #include "vardata.h"
 
-/** prepares tour variable to be added to be model */
-SCIP_RETCODE add_tour_variable(
-        SCIP*                       scip,
-        vrp::ProbDataVRP*           probData,
+#if COLUMN_NAMES
+/** writes the name of the column of a tour */
+static
+void setColumnName(
+        char*                       name,
         SCIP_Bool                   isFarkas,
-        SCIP_Bool                   isInitial,
         char*                       algoName,
         tourVRP&                    tvrp
 ){
-    char name[SCIP_MAXSTRLEN];
-    char str_tmp[SCIP_MAXSTRLEN];
-    int i;
+    int len;
 
     /* create variable name */
     if (!isFarkas)
     {
-        (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "%sRed_%2d: ", algoName, tvrp.getDay());
+        len = SCIPsnprintf(name, SCIP_MAXSTRLEN, "%sRed_%2d: ", algoName, tvrp.getDay());
     } else {
-        (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "%sFar_%2d: ", algoName, tvrp.getDay());
+        len = SCIPsnprintf(name, SCIP_MAXSTRLEN, "%sFar_%2d: ", algoName, tvrp.getDay());
     }
-    for (i = 0; i < tvrp.length_; i++)
+    for (int i = 0; i < tvrp.length_ && len < SCIP_MAXSTRLEN; i++)
     {
-        (void) SCIPsnprintf(str_tmp, SCIP_MAXSTRLEN, "_%d", tvrp.tour_[i]);
-        strcat(name, str_tmp);
+        len += SCIPsnprintf(name + len, SCIP_MAXSTRLEN - len, "_%d", tvrp.tour_[i]);
     }
+}
+#endif
 
+/** prepares tour variable to be added to be model */
+SCIP_RETCODE add_tour_variable(
+        SCIP*                       scip,
+        vrp::ProbDataVRP*           probData,
+        SCIP_Bool                   isFarkas,
+        SCIP_Bool                   isInitial,
+        char*                       algoName,
+        tourVRP&                    tvrp
+){
+#if COLUMN_NAMES
+    char name[SCIP_MAXSTRLEN];
+
+    setColumnName(name, isFarkas, algoName, tvrp);
     SCIP_CALL(SCIPcreateColumn(scip, probData, name, isInitial, tvrp));
+#else
+    (void) isFarkas;
+    (void) algoName;
+    /* SCIP gives the column a short generic name */
+    SCIP_CALL(SCIPcreateColumn(scip, probData, nullptr, isInitial, tvrp));
+#endif
+
+    return SCIP_OKAY;
+}
+
+/** adds the columns of several priced tours to the model in one batch */
+SCIP_RETCODE add_tour_variables(
+        SCIP*                       scip,
+        vrp::ProbDataVRP*           probData,
+        SCIP_Bool                   isFarkas,
+        char*                       algoName,
+        vector<tourVRP*>&           tours
+){
+    vector<string> names;
+#if COLUMN_NAMES
+    char name[SCIP_MAXSTRLEN];
+
+    names.reserve(tours.size());
+    for(auto* tvrp : tours)
+    {
+        setColumnName(name, isFarkas, algoName, *tvrp);
+        names.emplace_back(name);
+    }
+#else
+    (void) isFarkas;
+    (void) algoName;
+#endif
+    SCIP_CALL(SCIPcreateColumns(scip, probData, names, tours));
 
     return SCIP_OKAY;
 }
@@ -47,7 +92,7 @@ double getExchangeCosts(
         int                     pos
 ){
     double tmp_new, tmp_old;
-    vector<vector<double>>& tr = modelData->travel;
+    travel_matrix& tr = modelData->travel;
     assert(length > 0);
     assert(pos < length);
     /* in-going arc */
@@ -406,4 +451,89 @@ bool violatesNGProperty(
         ng_memory[u] = true;
     }
     return violates;
-}
\ No newline at end of file
+}
+
+/** collects the tours of a solution and repairs it to a set partitioning solution */
+SCIP_RETCODE getPartitioningTours(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData,
+        SCIP_SOL*               sol,
+        vector<tourVRP>&        tours,
+        bool*                   repaired,
+        bool*                   success
+){
+    model_data* modelData = probData->getData();
+    vector<int> nVisits(modelData->nC, 0);
+    *repaired = false;
+    *success = true;
+
+    tours.clear();
+    for(auto var : probData->vars_)
+    {
+        if(SCIPgetSolVal(scip, sol, var) < 0.5)
+            continue;
+        auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
+        if(vardata->getLength() == 0)
+            continue;
+        tours.emplace_back();
+        vardata->getTourVRP(tours.back());
+        for(auto u : vardata->getTour())
+            nVisits[u]++;
+    }
+
+    /* remove the visits of overcovered customers with the largest savings, as long as the tours stay feasible */
+    for(int u = 1; u < modelData->nC; u++)
+    {
+        while(nVisits[u] > 1)
+        {
+            int bestTour = -1;
+            int bestPos = -1;
+            double bestCosts = SCIP_DEFAULT_INFINITY;
+            for(int t = 0; t < (int) tours.size(); t++)
+            {
+                tourVRP& tvrp = tours[t];
+                for(int pos = 0; pos < tvrp.length_; pos++)
+                {
+                    if(tvrp.tour_[pos] != u)
+                        continue;
+                    double costs = getDeleteCosts(modelData, tvrp.tour_, tvrp.length_, pos);
+                    if(costs >= bestCosts)
+                        continue;
+                    if(tvrp.length_ > 1)
+                    {
+                        tourVRP shortened;
+                        shortened.copy(tvrp);
+                        shortened.tour_.erase(shortened.tour_.begin() + pos);
+                        shortened.length_--;
+                        if(!shortened.isFeasible(modelData))
+                            continue;
+                    }
+                    bestTour = t;
+                    bestPos = pos;
+                    bestCosts = costs;
+                }
+            }
+            /* removing the customer would violate a time window (no triangle inequality) */
+            if(bestTour == -1)
+            {
+                *success = false;
+                tours.clear();
+                return SCIP_OKAY;
+            }
+            tourVRP& tvrp = tours[bestTour];
+            tvrp.tour_.erase(tvrp.tour_.begin() + bestPos);
+            tvrp.length_--;
+            if(tvrp.length_ > 0)
+                SCIP_CALL(tvrp.setValues(modelData));
+            nVisits[u]--;
+            *repaired = true;
+        }
+    }
+    if(*repaired)
+    {
+        tours.erase(remove_if(tours.begin(), tours.end(), [](const tourVRP& tvrp){ return tvrp.length_ == 0; }),
+                    tours.end());
+    }
+
+    return SCIP_OKAY;
+}
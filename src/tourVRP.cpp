@@ -4,15 +4,15 @@
 SCIP_Bool tourVRP::isFeasible(
         model_data *modelData
 ){
-    vector<vector<double>>& tr = modelData->travel;
-    vector<vector<timeWindow>>& tws = modelData->timeWindows;
+    travel_matrix& tr = modelData->travel;
+    customer_day_table<timeWindow>& tws = modelData->timeWindows;
     assert(length_ > 0);
     /* initialize for first customer */
     int cap = modelData->demand[tour_[0]];
     if(cap > modelData->max_caps[day_])
         cout << cap << " vs " << modelData->max_caps[day_] << " cust: " << tour_[0]  << " day " << day_ << endl;
     assert(cap <= modelData->max_caps[day_]);
-    double time = max((double) tws[tour_[0]][day_].start, tws[0][day_].start + tr[0][tour_[0]]);
+    double time = max((double) tws[tour_[0]][day_].start, tws[0][day_].start + (double) tr[0][tour_[0]]);
     /* check if first customer is reachable within time window */
     if(time > tws[tour_[0]][day_].end + 0.00001)
         return FALSE;
@@ -60,14 +60,26 @@ SCIP_Bool tourVRP::addNode(
         model_data* modelData,
         int         *newpos,
         int         cust
+) {
+    return addNode(modelData, newpos, cust, SCIPsumepsilon(scip));
+}
+
+/** try to add cust to the cheapest spot without SCIP, e.g. in other threads than the one of SCIP
+ * @return FALSE if no spot was found
+ *         TRUE else */
+SCIP_Bool tourVRP::addNode(
+        model_data* modelData,
+        int         *newpos,
+        int         cust,
+        SCIP_Real   sumepsilon
 ) {
     int i;
     tourVRP tmpTour(length_ + 2, day_);
     double extracosts;                              // costs of adding the customer
     double bestcosts = SCIP_DEFAULT_INFINITY;
     int bestpos = -1;
-    vector<vector<double>>& tr = modelData->travel;
-    vector<vector<timeWindow>>& tws = modelData->timeWindows;
+    travel_matrix& tr = modelData->travel;
+    customer_day_table<timeWindow>& tws = modelData->timeWindows;
 
     /* initialize with new customer at first position */
     tmpTour.length_--;
@@ -80,7 +92,7 @@ SCIP_Bool tourVRP::addNode(
     tmpTour.tour_[i] = 0;
 
     extracosts = tr[0][cust] + tr[cust][tmpTour.tour_[1]] - tr[0][tmpTour.tour_[1]];
-    if(SCIPisSumNegative(scip, extracosts - bestcosts))
+    if(extracosts - bestcosts < -sumepsilon)
     {
         /* check for necessary conditions of feasiblity first */
         if(tws[cust][day_].start + modelData->service[cust] <= tws[tmpTour.tour_[1]][day_].end)
@@ -102,7 +114,7 @@ SCIP_Bool tourVRP::addNode(
 
         /* check if the extra costs are the lowest so far */
         extracosts = tr[tmpTour.tour_[i-1]][cust] + tr[cust][tmpTour.tour_[i+1]] - tr[tmpTour.tour_[i-1]][tmpTour.tour_[i+1]];
-        if(SCIPisSumNegative(scip, extracosts - bestcosts))
+        if(extracosts - bestcosts < -sumepsilon)
         {
             /* check for necessary conditions first */
             if(tws[cust][day_].end < tws[tmpTour.tour_[i-1]][day_].start + modelData->service[tmpTour.tour_[i-1]])
@@ -218,7 +230,7 @@ SCIP_RETCODE tourVRP::setValues(
     for(int i = 1; i < length_; i++)
     {
         obj += modelData->travel[tour_[i-1]][tour_[i]];
-        capacity += modelData->demand[i];
+        capacity += modelData->demand[tour_[i]];
     }
 
     obj_ = obj;
@@ -24,12 +24,14 @@ SCIP_RETCODE getArcFlowValues(
     vector<vector<SCIP_Real>>&  values,
     int*                        narcs
 ){
-    auto* probData = dynamic_cast<vrp::ProbDataVRP*>(SCIPgetObjProbData(scip));
+    SCIP_COL** cols = SCIPgetLPCols(scip);
     *narcs = 0;
     SCIP_Real lpval;
 
-    for(auto var : probData->vars_)
+    /* columns removed from the LP by the aging have value zero */
+    for(int c = 0; c < SCIPgetNLPCols(scip); c++)
     {
+        SCIP_VAR* var = SCIPcolGetVar(cols[c]);
         lpval = SCIPvarGetLPSol(var);
 
         if(SCIPisSumPositive(scip, lpval))
@@ -59,10 +61,11 @@ SCIP_RETCODE getVehiAssValues(
 ){
     int j, day;
     SCIP_Real lpval;
-    auto* probData = dynamic_cast<vrp::ProbDataVRP*>(SCIPgetObjProbData(scip));
+    SCIP_COL** cols = SCIPgetLPCols(scip);
 
-    for(auto var : probData->vars_)
+    for(int c = 0; c < SCIPgetNLPCols(scip); c++)
     {
+        SCIP_VAR* var = SCIPcolGetVar(cols[c]);
         lpval = SCIPvarGetLPSol(var);
 
         if(SCIPisSumPositive(scip, lpval))
@@ -81,6 +84,42 @@ SCIP_RETCODE getVehiAssValues(
     return SCIP_OKAY;
 }
 
+SCIP_RETCODE SCIPaddVarsToCutRow(
+        SCIP*                       scip,
+        SCIP_ROW*                   cut,
+        SCIP_VAR***                 consvars,
+        SCIP_Real**                 conscoeffs,
+        int*                        nconsvars,
+        int*                        varssize,
+        int                         nvars,
+        SCIP_VAR**                  vars,
+        SCIP_Real*                  vals
+){
+    assert(cut != nullptr);
+    assert(nvars == 0 || (vars != nullptr && vals != nullptr));
+
+    if(nvars == 0)
+        return SCIP_OKAY;
+    if(*nconsvars + nvars > *varssize)
+    {
+        int newsize = SCIPcalcMemGrowSize(scip, *nconsvars + nvars);
+        SCIP_CALL( SCIPreallocBlockMemoryArray(scip, consvars, *varssize, newsize) );
+        SCIP_CALL( SCIPreallocBlockMemoryArray(scip, conscoeffs, *varssize, newsize) );
+        *varssize = newsize;
+    }
+    for(int i = 0; i < nvars; i++)
+    {
+        (*consvars)[*nconsvars + i] = vars[i];
+        (*conscoeffs)[*nconsvars + i] = vals[i];
+    }
+    *nconsvars += nvars;
+
+    /* one update of the row instead of one per coefficient */
+    SCIP_CALL( SCIPaddVarsToRow(scip, cut, nvars, vars, vals) );
+
+    return SCIP_OKAY;
+}
+
 bool varInRow(
         SCIP_VAR*                   var,
         SCIP_ROW*                   row
@@ -106,9 +145,11 @@ SCIP_RETCODE SCIPsortNonzeroVars(
         SCIP*                       scip,
         vrp::ProbDataVRP*           probData
 ){
+    SCIP_COL** cols = SCIPgetLPCols(scip);
     assert(probData->nonzeroVars_.empty());
-    for(auto* var : probData->vars_)
+    for(int c = 0; c < SCIPgetNLPCols(scip); c++)
     {
+        SCIP_VAR* var = SCIPcolGetVar(cols[c]);
         if(SCIPisPositive(scip, SCIPvarGetLPSol(var)))
         {
             probData->nonzeroVars_.push_back(var);
@@ -124,3 +165,21 @@ SCIP_RETCODE SCIPsortNonzeroVars(
 
     return SCIP_OKAY;
 }
+
+bool SCIPhasPooledColumns(
+        SCIP*                       scip,
+        vrp::ProbDataVRP*           probData
+){
+    /* all variables of the problem are in the LP */
+    if(SCIPgetNLPCols(scip) >= SCIPgetNVars(scip))
+        return false;
+    /* the tour variables are checked themselves, the number of LP columns also counts other columns (e.g. the ones of
+     * the empty tours) and does not tell which tour columns left the LP */
+    for(int i = 0; i < probData->nVars_; i++)
+    {
+        SCIP_VAR* var = probData->vars_[i];
+        if(SCIPvarGetStatus(var) == SCIP_VARSTATUS_COLUMN && !SCIPvarIsInLP(var))
+            return true;
+    }
+    return false;
+}
@@ -17,17 +17,21 @@ bool SCIPcontainsTourVar(
         SCIP_Var**              existingVar,
         tourVRP&                tvrp
 ){
-    for(auto var : probData->vars_)
+    if(tvrp.length_ == 0)
+        return false;
+    /* only the columns of the day that start with the same customer can be equal */
+    for(int col : probData->columnIndex_.getCustomerDay(tvrp.tour_[0], tvrp.getDay()))
     {
-        tourVRP& tvrp_old = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var))->tourVrp_;
-        if(tvrp_old.getDay() != tvrp.getDay())
+        SCIP_VAR* var = probData->vars_[col];
+        auto* vardata = dynamic_cast<ObjVarDataVRP*>(SCIPgetObjVardata(scip, var));
+        if(vardata->tour_[0] != tvrp.tour_[0])
             continue;
-        if(tvrp_old.length_ != tvrp.length_)
+        if(vardata->getLength() != tvrp.length_)
             continue;
         bool same = true;
         for(int i = 0; i < tvrp.length_; i++)
         {
-            if(tvrp_old.tour_[i] != tvrp.tour_[i])
+            if(vardata->tour_[i] != tvrp.tour_[i])
             {
                 same = false;
                 break;
@@ -151,12 +155,15 @@ SCIP_RETCODE addVarToKPC(
     return SCIP_OKAY;
 }
 
-SCIP_RETCODE SCIPcreateColumn(
+/** creates the variable of a column and adds it to the customer and day constraints of the master problem */
+static
+SCIP_RETCODE createColumnVar(
         SCIP*                   scip,
         vrp::ProbDataVRP*       probData,
         const char*             name,
         SCIP_Bool               initial,
-        tourVRP&                tvrp
+        tourVRP&                tvrp,
+        SCIP_VAR**              varPtr
 ){
     ObjVarDataVRP* varData;
     SCIP_VAR* var;
@@ -169,15 +176,19 @@ SCIP_RETCODE SCIPcreateColumn(
     assert(tvrp.getDay() >= 0);
 
 //    assert(tvrp.isFeasible(modelData));
-    /* generate coefficients */
+    /* check for customers visited more than once (their coefficient is the number of visits) */
     bool isElementary = true;
-    vector<double> coeffs(modelData->nC, 0.0);
-    for(i = 0; i < tvrp.length_; i++)
+    for(i = 0; i < tvrp.length_ && isElementary; i++)
     {
-        if(coeffs[tvrp.tour_[i]] > 0)
-            isElementary = false;
         assert(0 < tvrp.tour_[i] && tvrp.tour_[i] < modelData->nC);
-        coeffs[tvrp.tour_[i]] += 1.0;
+        for(int j = 0; j < i; j++)
+        {
+            if(tvrp.tour_[j] == tvrp.tour_[i])
+            {
+                isElementary = false;
+                break;
+            }
+        }
     }
 
 //    SCIP_Var* test;
@@ -190,8 +201,8 @@ SCIP_RETCODE SCIPcreateColumn(
 ////        assert(false);
 //    }
 
-    // TODO: only tvrp in vardata
-    varData = new ObjVarDataVRP(tvrp, tvrp.tour_, tvrp.length_, tvrp.getDay(), tvrp.capacity_, isElementary);
+    varData = new ObjVarDataVRP(probData->columns_.add(tvrp.tour_.data(), tvrp.length_), tvrp.length_, tvrp.getDay(),
+                                tvrp.capacity_, tvrp.obj_, isElementary);
     /* create variable for the vrp which contains only this customer */
     if(!modelData->minTravel)
         tvrp.obj_ = 1.0;
@@ -227,13 +238,29 @@ SCIP_RETCODE SCIPcreateColumn(
     {
         SCIP_CALL( SCIPprobdataAddVar(scip, probData, var) );
     }
-    for(auto u : tvrp.tour_)
+    for(i = 0; i < tvrp.length_; i++)
     {
-        if (coeffs[u] == 0)
-            continue;
+        int u = tvrp.tour_[i];
+        double coeff = 1.0;
+        if(!isElementary)
+        {
+            /* the coefficient is added at the first visit of u */
+            bool visited = false;
+            for(int j = 0; j < tvrp.length_; j++)
+            {
+                if(j != i && tvrp.tour_[j] == u)
+                {
+                    if(j < i)
+                        visited = true;
+                    else
+                        coeff += 1.0;
+                }
+            }
+            if(visited)
+                continue;
+        }
         assert(!strncmp(SCIPconshdlrGetName(SCIPconsGetHdlr(probData->cons_[u - 1])), "linear", 6));
-        SCIP_CALL(SCIPaddCoefLinear(scip, probData->cons_[u - 1], var, coeffs[u]));
-        coeffs[u] = 0;
+        SCIP_CALL(SCIPaddCoefLinear(scip, probData->cons_[u - 1], var, coeff));
     }
 
 //    for(i = 1; i < modelData->nC; i++)
@@ -255,6 +282,20 @@ SCIP_RETCODE SCIPcreateColumn(
         SCIP_CALL( SCIPaddCoefLinear(scip, probData->cons_[modelData->nC - 1 + tvrp.getDay()], var, 1) );
     }
 
+    *varPtr = var;
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE SCIPcreateColumn(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData,
+        const char*             name,
+        SCIP_Bool               initial,
+        tourVRP&                tvrp
+){
+    SCIP_VAR* var;
+
+    SCIP_CALL(createColumnVar(scip, probData, name, initial, tvrp, &var));
 
     if(!initial)
     {
@@ -278,4 +319,155 @@ SCIP_RETCODE SCIPcreateColumn(
     return SCIP_OKAY;
 }
 
+SCIP_RETCODE SCIPcreateColumns(
+        SCIP*                   scip,
+        vrp::ProbDataVRP*       probData,
+        vector<string>&         names,
+        vector<tourVRP*>&       tours
+){
+    model_data* modelData = probData->getData();
+    int nTours = (int) tours.size();
+    int c, k, i;
+    assert(names.empty() || (int) names.size() == nTours);
+
+    if(nTours == 0)
+        return SCIP_OKAY;
+
+    vector<SCIP_VAR*> vars(nTours);
+    for(k = 0; k < nTours; k++)
+    {
+        SCIP_CALL(createColumnVar(scip, probData, names.empty() ? nullptr : names[k].c_str(), FALSE,
+                                  *tours[k], &vars[k]));
+    }
+
+    /* the cuts only contain a few customers each, so instead of testing every tour against every cut, the cuts
+     * of each customer are listed once and only the cuts of the visited customers are evaluated */
+    vector<vector<int>> cutsOfCustomer(modelData->nC);
+    vector<double> count;
+    vector<int> touched;
+    vector<SCIP_VAR*> cutVars;
+    vector<SCIP_Real> cutVals;
+
+    /* subset row cuts */
+    SCIP_CONSHDLR* conshdlr = SCIPfindConshdlr(scip, "SRC");
+    int nConss = SCIPconshdlrGetNConss(conshdlr);
+    SCIP_CONS** conss = SCIPconshdlrGetConss(conshdlr);
+    if(nConss > 0)
+    {
+        vector<vector<pair<int, SCIP_Real>>> coeffs(nConss);
+        for(c = 0; c < nConss; c++)
+        {
+            vector<bool>& setS = *SCIPgetSetOfSRC(conss[c]);
+            for(int u = 1; u < modelData->nC; u++)
+            {
+                if(setS[u])
+                    cutsOfCustomer[u].push_back(c);
+            }
+        }
+        count.assign(nConss, 0.0);
+        for(k = 0; k < nTours; k++)
+        {
+            for(i = 0; i < tours[k]->length_; i++)
+            {
+                for(int cut : cutsOfCustomer[tours[k]->tour_[i]])
+                {
+                    if(count[cut] == 0.0)
+                        touched.push_back(cut);
+                    count[cut] += 1.0;
+                }
+            }
+            for(int cut : touched)
+            {
+                double val = floor(SCIPgetpOfSRC(conss[cut]) * count[cut]);
+                if(SCIPisPositive(scip, val))
+                    coeffs[cut].emplace_back(k, val);
+                count[cut] = 0.0;
+            }
+            touched.clear();
+        }
+        for(c = 0; c < nConss; c++)
+        {
+            if(coeffs[c].empty())
+                continue;
+            cutVars.clear();
+            cutVals.clear();
+            for(auto& coeff : coeffs[c])
+            {
+                cutVars.push_back(vars[coeff.first]);
+                cutVals.push_back(coeff.second);
+            }
+            SCIP_CALL(SCIPaddCoefsSRC(scip, conss[c], (int) cutVars.size(), cutVars.data(), cutVals.data()));
+        }
+    }
+
+    /* k-path cuts: the coefficient is the number of times the tour enters the set */
+    conshdlr = SCIPfindConshdlr(scip, "KPC");
+    nConss = SCIPconshdlrGetNConss(conshdlr);
+    conss = SCIPconshdlrGetConss(conshdlr);
+    if(nConss > 0)
+    {
+        vector<vector<pair<int, SCIP_Real>>> coeffs(nConss);
+        vector<vector<bool>*> sets(nConss);
+        for(auto& cuts : cutsOfCustomer)
+            cuts.clear();
+        for(c = 0; c < nConss; c++)
+        {
+            sets[c] = &SCIPgetSetOfKPC(conss[c]);
+            vector<bool>& setS = *sets[c];
+            for(int u = 1; u < modelData->nC; u++)
+            {
+                if(setS[u])
+                    cutsOfCustomer[u].push_back(c);
+            }
+        }
+        count.assign(nConss, 0.0);
+        for(k = 0; k < nTours; k++)
+        {
+            tourVRP& tvrp = *tours[k];
+            for(i = 0; i < tvrp.length_; i++)
+            {
+                for(int cut : cutsOfCustomer[tvrp.tour_[i]])
+                {
+                    if(i > 0 && (*sets[cut])[tvrp.tour_[i-1]])
+                        continue;
+                    if(count[cut] == 0.0)
+                        touched.push_back(cut);
+                    count[cut] += 1.0;
+                }
+            }
+            for(int cut : touched)
+            {
+                coeffs[cut].emplace_back(k, count[cut]);
+                count[cut] = 0.0;
+            }
+            touched.clear();
+        }
+        for(c = 0; c < nConss; c++)
+        {
+            if(coeffs[c].empty())
+                continue;
+            cutVars.clear();
+            cutVals.clear();
+            for(auto& coeff : coeffs[c])
+            {
+                cutVars.push_back(vars[coeff.first]);
+                cutVals.push_back(coeff.second);
+            }
+            SCIP_CALL(SCIPaddCoefsKPC(scip, conss[c], (int) cutVars.size(), cutVars.data(), cutVals.data()));
+        }
+    }
+
+    for(k = 0; k < nTours; k++)
+    {
+        /* add var to vehicle constraints */
+        SCIP_CALL(addVarToVehicleCons(scip, *tours[k], vars[k]));
+
+        /* add var to nVehicle constraint */
+        SCIP_CALL(addVarToNVehicleCons(scip, vars[k]));
+
+        /* release variable */
+        SCIP_CALL( SCIPreleaseVar(scip, &vars[k]) );
+    }
 
+    return SCIP_OKAY;
+}